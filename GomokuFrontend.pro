@@ -33,9 +33,30 @@ VPATH += . \
         src/widgets \
         src/utils
 
-SOURCES += src/core/AiPlayer.cpp \
+SOURCES += src/core/AiEngine.cpp \
+           src/core/AiPlayer.cpp \
+           src/core/AiService.cpp \
+           src/core/Bitboard.cpp \
+           src/core/CandidateSet.cpp \
            src/core/Controller.cpp \
+           src/core/CpuFeatures.cpp \
+           src/core/Evaluator.cpp \
            src/core/Game.cpp \
+           src/core/GameRecord.cpp \
+           src/core/Heuristics.cpp \
+           src/core/MctsPlayer.cpp \
+           src/core/MovePicker.cpp \
+           src/core/Nnue.cpp \
+           src/core/OpeningBook.cpp \
+           src/core/PatternBatch.cpp \
+           src/core/PatternTable.cpp \
+           src/core/ProofSolver.cpp \
+           src/core/ThreatSolver.cpp \
+           src/core/Threats.cpp \
+           src/core/TimeManager.cpp \
+           src/core/Position.cpp \
+           src/core/TranspositionTable.cpp \
+           src/core/Zobrist.cpp \
            src/network/Client.cpp \
            src/network/Frame.cpp \
            src/network/Packet.cpp \
@@ -48,9 +69,33 @@ SOURCES += src/core/AiPlayer.cpp \
            src/main.cpp \
            src/MainWindow.cpp
 
-HEADERS += src/core/AiPlayer.h \
+HEADERS += src/core/AiEngine.h \
+           src/core/AiPlayer.h \
+           src/core/AiService.h \
+           src/core/Bitboard.h \
+           src/core/CandidateSet.h \
            src/core/Controller.h \
+           src/core/CpuFeatures.h \
+           src/core/Evaluator.h \
+           src/core/EvalWeights.h \
            src/core/Game.h \
+           src/core/GameRecord.h \
+           src/core/Heuristics.h \
+           src/core/MctsPlayer.h \
+           src/core/MovePicker.h \
+           src/core/Nnue.h \
+           src/core/OpeningBook.h \
+           src/core/PatternBatch.h \
+           src/core/PatternTable.h \
+           src/core/ProofSolver.h \
+           src/core/SearchTypes.h \
+           src/core/ThreatSolver.h \
+           src/core/Threats.h \
+           src/core/TimeManager.h \
+           src/core/Position.h \
+           src/core/TranspositionTable.h \
+           src/core/WinDetector.h \
+           src/core/Zobrist.h \
            src/network/Client.h \
            src/network/Frame.h \
            src/network/Packet.h \
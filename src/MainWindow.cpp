@@ -148,6 +148,7 @@ void MainWindow::SetUpSignals()
     connect(ctrl.get(), &Controller::makeMove, room, &RoomWidget::onMakeMove);
 
     connect(ctrl.get(), &Controller::syncGame, room, &RoomWidget::onSyncGame);
+    connect(ctrl.get(), &Controller::syncGameRecord, room, &RoomWidget::onSyncGameRecord);
     connect(ctrl.get(), &Controller::draw, room, &RoomWidget::onDraw);
     connect(ctrl.get(), &Controller::undoMove, room, &RoomWidget::onUndoMove);
 
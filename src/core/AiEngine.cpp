@@ -0,0 +1,15 @@
+#include "AiEngine.h"
+#include "AiPlayer.h"
+#include "MctsPlayer.h"
+
+std::unique_ptr<AiEngine> AiEngine::create(Kind kind, Piece color)
+{
+    switch (kind)
+    {
+    case Kind::Mcts:
+        return std::make_unique<MctsPlayer>(color);
+    case Kind::AlphaBeta:
+    default:
+        return std::make_unique<AiPlayer>(color);
+    }
+}
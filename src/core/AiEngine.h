@@ -0,0 +1,47 @@
+#ifndef AIENGINE_H
+#define AIENGINE_H
+
+#include "Game.h"
+#include "SearchTypes.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief AI 引擎公共接口
+ *
+ * 界面层（RoomWidget / AiService）只通过该接口驱动 AI，具体后端由 create() 按种类构造：
+ *   - AlphaBeta：迭代加深 Alpha-Beta（AiPlayer）
+ *   - Mcts：蒙特卡洛树搜索（MctsPlayer），SearchLimits::nodes 解释为模拟次数
+ */
+class AiEngine
+{
+public:
+    enum class Kind
+    {
+        AlphaBeta,
+        Mcts
+    };
+
+    virtual ~AiEngine() = default;
+
+    static std::unique_ptr<AiEngine> create(Kind kind, Piece color);
+
+    virtual void setBoardSize(int size) = 0;
+    virtual void setSearchLimits(const SearchLimits &searchLimits) = 0;
+    virtual std::pair<int, int> getNextMove(const BoardView &board) = 0;
+    // 兼容旧接口：二维数组先复制为快照
+    std::pair<int, int> getNextMove(const std::vector<std::vector<Piece>> &board)
+    {
+        BoardSnapshot snapshot = BoardSnapshot::fromRows(board);
+        return getNextMove(snapshot.view());
+    }
+    virtual Piece getColor() const = 0;
+
+    // 可从其他线程调用：让正在进行的 getNextMove 尽快返回当前最好的着法
+    virtual void abortSearch() = 0;
+    // 清除中止请求，须在下一次 getNextMove 之前调用
+    virtual void clearAbort() = 0;
+};
+
+#endif // AIENGINE_H
@@ -1,12 +1,24 @@
 #include "AiPlayer.h"
+#include "Heuristics.h"
+#include "MovePicker.h"
+#include "PatternBatch.h"
 #include <algorithm>
+#include <chrono>
 #include <climits>
 #include <cmath>
 #include <random>
-#include <unordered_map>
-#include <string>
+#include <memory>
+#include <thread>
 
-AiPlayer::AiPlayer(Piece color) : aiColor(color), boardSize(15) {}
+AiPlayer::AiPlayer(Piece color)
+    : aiColor(color), boardSize(15), tt(GameConfig::DEFAULT_AI_HASH_MB), proofSolver(GameConfig::DEFAULT_AI_PN_MB)
+{
+    proofSolver.setNodeLimit(GameConfig::DEFAULT_AI_PN_NODES);
+    proofSolver.setStopFlag(&abortRequested);
+    threatSolver.setStopFlag(&abortRequested);
+    // 默认开局库不存在时静默跳过
+    book.open(GameConfig::DEFAULT_AI_BOOK_PATH);
+}
 
 AiPlayer::~AiPlayer() {}
 
@@ -15,6 +27,79 @@ void AiPlayer::setBoardSize(int size)
     boardSize = size;
 }
 
+void AiPlayer::setHashSize(int megabytes)
+{
+    tt.resize(megabytes);
+}
+
+bool AiPlayer::loadBook(const std::string &path)
+{
+    return book.open(path);
+}
+
+bool AiPlayer::loadNetwork(const std::string &path)
+{
+    if (network.load(path))
+        return true;
+    evalKind = EvalKind::Pattern;
+    return false;
+}
+
+bool AiPlayer::setEvalKind(EvalKind kind)
+{
+    if (kind == EvalKind::Nnue && !network.isLoaded())
+        return false;
+    evalKind = kind;
+    return true;
+}
+
+void AiPlayer::setSearchLimits(const SearchLimits &searchLimits)
+{
+    limits = searchLimits;
+}
+
+void AiPlayer::setClock(int remainingMs, int incrementMs)
+{
+    timeManager.setClock(remainingMs, incrementMs);
+}
+
+void AiPlayer::setThreads(int count)
+{
+    threadCount = std::max(0, count);
+}
+
+void AiPlayer::setStatsListener(std::function<void(const SearchStats &)> listener, bool perIteration)
+{
+    statsListener = std::move(listener);
+    statsPerIteration = perIteration;
+}
+
+void AiPlayer::setProfiling(bool enabled)
+{
+    profiling = enabled;
+}
+
+void AiPlayer::abortSearch()
+{
+    abortRequested = true;
+    stop = true;
+}
+
+void AiPlayer::clearAbort()
+{
+    abortRequested = false;
+}
+
+bool AiPlayer::shouldStop()
+{
+    if (abortRequested.load(std::memory_order_relaxed))
+        return true;
+    uint64_t total = sharedNodes.fetch_add(1024, std::memory_order_relaxed) + 1024;
+    if (limits.nodes > 0 && total >= limits.nodes)
+        return true;
+    return timeManager.hardExpired();
+}
+
 Piece AiPlayer::getColor() const
 {
     return aiColor;
@@ -25,203 +110,123 @@ bool AiPlayer::isInBoard(int x, int y) const
     return x >= 0 && x < boardSize && y >= 0 && y < boardSize;
 }
 
-// 棋形评分表 - 使用静态变量在函数内部定义
 namespace {
-    const std::unordered_map<std::string, int> PATTERN_SCORES = {
-        {"11111", 1000000},   // 连五
-        {"011110", 10000},    // 活四
-        {"011112", 1000},     // 冲四（左）
-        {"211110", 1000},     // 冲四（右）
-        {"01110", 1000},      // 活三
-        {"01112", 100},       // 眠三（左）
-        {"21110", 100},       // 眠三（右）
-        {"0011100", 500},     // 跳活三
-        {"010110", 300},      // 弯三
-        {"011010", 300},      // 弯三
-        {"001100", 50},       // 活二
-        {"001120", 10},       // 眠二（左）
-        {"021100", 10},       // 眠二（右）
-        {"01010", 30},        // 跳二
-        {"0010100", 20},      // 大跳二
-    };
+    // 威胁空间预检的深度（攻方步数）与节点预算上限
+    constexpr int VCF_DEPTH = 12;
+    constexpr uint64_t VCF_NODES = 100000;
+    constexpr int VCT_DEPTH = 5;
+    constexpr uint64_t VCT_NODES = 10000;
+    // 预检最多占本步 hard 期限的 1/THREAT_TIME_SHARE，按实测约每毫秒 THREAT_NODES_PER_MS 个节点折算预算
+    constexpr int THREAT_TIME_SHARE = 4;
+    constexpr uint64_t THREAT_NODES_PER_MS = 300;
 
-    // 辅助函数：获取棋盘位置的字符表示
-    char getPieceChar(Piece piece) {
-        if (piece == Piece::BLACK) return '1';
-        if (piece == Piece::WHITE) return '2';
-        return '0';
-    }
+    // 内部节点保留的候选着法数（贪心剪枝）
+    constexpr int MOVE_LIMIT = 20;
 
-    // 辅助函数：在指定方向上获取棋形字符串
-    std::string getPatternInDirection(const std::vector<std::vector<Piece>> &board, int x, int y,
-                                      int dx, int dy, int length, Piece player, int boardSize) {
-        std::string pattern;
-        char playerChar = getPieceChar(player);
-        char opponentChar = (playerChar == '1') ? '2' : '1';
-        
-        for (int i = -length; i <= length; i++) {
-            int nx = x + i * dx;
-            int ny = y + i * dy;
-            
-            if (nx >= 0 && nx < boardSize && ny >= 0 && ny < boardSize) {
-                char c = getPieceChar(board[nx][ny]);
-                // 如果是对方棋子，转换为'2'，空位为'0'，己方棋子为'1'
-                if (c == playerChar) {
-                    pattern += '1';
-                } else if (c != '0') {
-                    pattern += '2'; // 对方棋子
-                } else {
-                    pattern += '0'; // 空位
-                }
-            } else {
-                pattern += '2'; // 边界视为对方棋子（阻挡）
-            }
-        }
-        return pattern;
+    // 渴望窗口的初始半宽与启用所需的最小完成深度
+    constexpr int ASPIRATION_DELTA = 50;
+    constexpr int ASPIRATION_MIN_DEPTH = 3;
+
+    // 主搜索分数达到此值（约为冲四加活三）即视为可能存在强制胜，交给证明数搜索
+    constexpr int HANDOFF_SCORE = 1000;
+    // 证明数搜索实测约每毫秒 PN_NODES_PER_MS 个节点，用于把剩余时间折算成节点预算
+    constexpr uint64_t PN_NODES_PER_MS = 100;
+
+    // 胜负分在置换表中按“距当前节点的层数”存储，读取时再换回“距根的层数”
+    int scoreToTT(int score, int ply)
+    {
+        if (score >= WIN_BOUND)
+            return score + ply;
+        if (score <= -WIN_BOUND)
+            return score - ply;
+        return score;
     }
 
-    // 计算单个位置的得分
-    int evaluatePosition(const std::vector<std::vector<Piece>> &board, int x, int y, Piece player, int boardSize) {
-        if (x < 0 || x >= boardSize || y < 0 || y >= boardSize || board[x][y] != Piece::EMPTY) return 0;
-        
-        int score = 0;
-        const std::vector<std::pair<int, int>> directions = {
-            {1, 0},  // 垂直
-            {0, 1},  // 水平
-            {1, 1},  // 主对角线
-            {1, -1}  // 副对角线
-        };
-        
-        // 检查四个方向
-        for (const auto &dir : directions) {
-            int dx = dir.first;
-            int dy = dir.second;
-            
-            // 获取7个位置的棋形（中心位置+左右各3个）
-            std::string pattern = getPatternInDirection(board, x, y, dx, dy, 3, player, boardSize);
-            
-            // 检查所有可能的子串匹配
-            for (const auto &[key, value] : PATTERN_SCORES) {
-                if (pattern.find(key) != std::string::npos) {
-                    score += value;
-                }
-            }
-        }
-        
+    int scoreFromTT(int score, int ply)
+    {
+        if (score >= WIN_BOUND)
+            return score - ply;
+        if (score <= -WIN_BOUND)
+            return score + ply;
         return score;
     }
 
-    // 检查是否有五子连珠（简化版）
-    bool checkFiveInRow(const std::vector<std::vector<Piece>> &board, int x, int y, Piece player, int boardSize) {
-        const std::vector<std::pair<int, int>> directions = {
-            {1, 0},  // 垂直
-            {0, 1},  // 水平
-            {1, 1},  // 主对角线
-            {1, -1}  // 副对角线
-        };
-        
-        for (const auto &dir : directions) {
-            int dx = dir.first;
-            int dy = dir.second;
-            int count = 1; // 当前位置已经有一个棋子
-            
-            // 正向检查
-            for (int i = 1; i < 5; i++) {
-                int nx = x + i * dx;
-                int ny = y + i * dy;
-                if (nx >= 0 && nx < boardSize && ny >= 0 && ny < boardSize && board[nx][ny] == player) {
-                    count++;
-                } else {
-                    break;
-                }
-            }
-            
-            // 反向检查
-            for (int i = 1; i < 5; i++) {
-                int nx = x - i * dx;
-                int ny = y - i * dy;
-                if (nx >= 0 && nx < boardSize && ny >= 0 && ny < boardSize && board[nx][ny] == player) {
-                    count++;
-                } else {
-                    break;
-                }
-            }
-            
-            if (count >= 5) {
-                return true;
-            }
+    // 开启计时时把作用域内的耗时（纳秒）累加到 sink
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(bool enabled, uint64_t &sink) : sink(enabled ? &sink : nullptr)
+        {
+            if (this->sink)
+                start = std::chrono::steady_clock::now();
+        }
+        ~ScopedTimer()
+        {
+            if (sink)
+                *sink += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
         }
-        
-        return false;
-    }
 
-    // 获取移动的启发式得分（用于排序）
-    int getMoveHeuristicScore(const std::vector<std::vector<Piece>> &board, int x, int y,
-                             Piece aiColor, Piece humanColor, int boardSize) {
-        int aiScore = evaluatePosition(board, x, y, aiColor, boardSize);
-        int humanScore = evaluatePosition(board, x, y, humanColor, boardSize);
-        return aiScore + humanScore * 2; // 防守更重要
+    private:
+        uint64_t *sink;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // 一步思考的计时范围：构造时开始计时，离开作用域时结算（扣除用时并加秒），覆盖所有返回路径
+    class MoveClock
+    {
+    public:
+        MoveClock(TimeManager &timeManager, const SearchLimits &limits, int ply) : timeManager(timeManager)
+        {
+            timeManager.start(limits, ply);
+        }
+        ~MoveClock() { timeManager.finish(); }
+        MoveClock(const MoveClock &) = delete;
+        MoveClock &operator=(const MoveClock &) = delete;
+
+    private:
+        TimeManager &timeManager;
+    };
+
+    double ratio(uint64_t part, uint64_t total)
+    {
+        return total ? double(part) / double(total) : 0.0;
     }
+
+    using Heuristics::getMoveHeuristicScore;
 }
 
 // 贪心算法：获取有潜力的移动位置（按得分排序）
-std::vector<std::pair<int, int>> AiPlayer::getValidMoves(const std::vector<std::vector<Piece>> &board) const
+std::vector<std::pair<int, int>> AiPlayer::getValidMoves(const Bitboard &board) const
 {
     std::vector<std::pair<int, int>> moves;
     std::vector<std::pair<int, std::pair<int, int>>> scoredMoves;
     
-    // 只考虑有棋子周围的空位（贪心剪枝）
-    for (int i = 0; i < boardSize; ++i)
+    // 只考虑有棋子周围的空位（距离2以内，位平面膨胀得到），整批计算启发式得分（防守分加倍）
+    int16_t cells[BoardBits::CELLS];
+    int32_t scores[BoardBits::CELLS];
+    int count = 0;
+    board.neighbours(2).forEach([&](int idx)
     {
-        for (int j = 0; j < boardSize; ++j)
-        {
-            if (board[i][j] == Piece::EMPTY)
-            {
-                // 检查周围是否有棋子（距离2以内）
-                bool hasNeighbor = false;
-                for (int dx = -2; dx <= 2 && !hasNeighbor; ++dx)
-                {
-                    for (int dy = -2; dy <= 2 && !hasNeighbor; ++dy)
-                    {
-                        int nx = i + dx;
-                        int ny = j + dy;
-                        if (isInBoard(nx, ny) && board[nx][ny] != Piece::EMPTY)
-                        {
-                            hasNeighbor = true;
-                        }
-                    }
-                }
-                
-                if (hasNeighbor)
-                {
-                    // 计算该位置的启发式得分
-                    int aiScore = evaluatePosition(board, i, j, aiColor, boardSize);
-                    Piece humanColor = (aiColor == Piece::BLACK) ? Piece::WHITE : Piece::BLACK;
-                    int humanScore = evaluatePosition(board, i, j, humanColor, boardSize);
-                    int totalScore = aiScore + humanScore * 2; // 防守更重要
-                    
-                    scoredMoves.push_back({totalScore, {i, j}});
-                }
-            }
-        }
+        cells[count++] = static_cast<int16_t>(idx);
+    });
+    PatternBatch::scoreMoves(board, cells, count, aiColor, scores);
+    for (int k = 0; k < count; ++k)
+    {
+        scoredMoves.push_back({scores[k], {BoardBits::toX(cells[k]), BoardBits::toY(cells[k])}});
     }
     
     // 如果没有找到有邻居的位置，返回中心附近的空位
     if (scoredMoves.empty())
     {
-        for (int i = 0; i < boardSize; ++i)
+        int center = board.size() / 2;
+        board.empties().forEach([&](int idx)
         {
-            for (int j = 0; j < boardSize; ++j)
-            {
-                if (board[i][j] == Piece::EMPTY)
-                {
-                    // 计算到中心的距离
-                    int center = boardSize / 2;
-                    int distance = std::abs(i - center) + std::abs(j - center);
-                    scoredMoves.push_back({-distance, {i, j}}); // 距离越近得分越高
-                }
-            }
-        }
+            int i = BoardBits::toX(idx);
+            int j = BoardBits::toY(idx);
+            // 计算到中心的距离
+            int distance = std::abs(i - center) + std::abs(j - center);
+            scoredMoves.push_back({-distance, {i, j}}); // 距离越近得分越高
+        });
     }
     
     // 按得分降序排序
@@ -238,186 +243,220 @@ std::vector<std::pair<int, int>> AiPlayer::getValidMoves(const std::vector<std::
     return moves;
 }
 
-int AiPlayer::evaluateBoard(const std::vector<std::vector<Piece>> &board, Piece aiColor) const
+int AiPlayer::evaluateBoard(const Position &pos, Piece aiColor) const
 {
-    int score = 0;
-    Piece humanColor = (aiColor == Piece::BLACK) ? Piece::WHITE : Piece::BLACK;
-    
-    // 检查整个棋盘的棋形
-    for (int i = 0; i < boardSize; ++i)
-    {
-        for (int j = 0; j < boardSize; ++j)
-        {
-            if (board[i][j] == aiColor)
-            {
-                // AI棋子的得分
-                score += evaluatePosition(board, i, j, aiColor, boardSize) / 10; // 除以10避免重复计算
-            }
-            else if (board[i][j] == humanColor)
-            {
-                // 人类棋子的威胁（负分）
-                score -= evaluatePosition(board, i, j, humanColor, boardSize) / 5; // 防守更重要
-            }
-        }
-    }
-    
-    // 添加位置权重：中心位置更有价值
-    int center = boardSize / 2;
-    for (int i = 0; i < boardSize; ++i)
-    {
-        for (int j = 0; j < boardSize; ++j)
-        {
-            if (board[i][j] == aiColor)
-            {
-                int distance = std::abs(i - center) + std::abs(j - center);
-                score += (boardSize - distance) * 2; // 越靠近中心得分越高
-            }
-            else if (board[i][j] == humanColor)
-            {
-                int distance = std::abs(i - center) + std::abs(j - center);
-                score -= (boardSize - distance) * 2; // 对手靠近中心是威胁
-            }
-        }
-    }
-    
-    return score;
+    // 棋形分与中心位置分都随落子/撤销增量维护，这里只做 O(1) 读取；
+    // NNUE 的累加器同样增量维护，这里只剩两层全连接的推理
+    if (evalKind == EvalKind::Nnue)
+        return pos.evaluateNnue(aiColor);
+    return pos.evaluate(aiColor);
 }
 
-int AiPlayer::minimax(std::vector<std::vector<Piece>> &board, int depth, bool isMaximizing,
-                      int alpha, int beta, Piece aiColor) const
+int AiPlayer::negamax(Worker &w, int depth, int alpha, int beta, Piece side)
 {
-    // 检查胜负（提前终止）
-    Piece humanColor = (aiColor == Piece::BLACK) ? Piece::WHITE : Piece::BLACK;
-    
-    // 深度限制
+    Position &pos = w.pos;
+    const Bitboard &board = pos.board();
+    // 每 1024 个节点检查一次期限，中止后逐层直接返回（返回值不再使用）
+    if ((++w.nodes & 1023) == 0 && shouldStop())
+        stop.store(true, std::memory_order_relaxed);
+    if (stop.load(std::memory_order_relaxed))
+        return 0;
+
+    int ply = std::min(board.stoneCount() - w.rootStones, MAX_PLY - 1);
+    w.seldepth = std::max(w.seldepth, ply);
+
+    // 深度限制：局面分始终以 AI 视角计算，再换到走子方视角
     if (depth == 0)
     {
-        return evaluateBoard(board, aiColor);
+        ++w.qnodes;
+        ScopedTimer timer(profiling, w.evalNs);
+        int score = evaluateBoard(pos, aiColor);
+        return side == aiColor ? score : -score;
     }
 
-    auto moves = getValidMoves(board);
-    if (moves.empty())
+    const bool pvNode = beta - alpha > 1;
+
+    // 查置换表：非 PV 节点上足够深的结果直接返回，否则只取其最佳着法用于排序
+    const int alphaOrig = alpha;
+    int ttMove = -1;
+    TranspositionTable::Entry entry;
+    ++w.ttProbes;
+    if (tt.probe(pos.hash(), entry))
     {
-        return evaluateBoard(board, aiColor);
+        ++w.ttHits;
+        ttMove = entry.move;
+        int ttScore = scoreFromTT(entry.score, ply);
+        if (!pvNode && entry.depth >= depth &&
+            (entry.bound() == TranspositionTable::Bound::Exact ||
+             (entry.bound() == TranspositionTable::Bound::Lower && ttScore >= beta) ||
+             (entry.bound() == TranspositionTable::Bound::Upper && ttScore <= alpha)))
+            return ttScore;
     }
 
-    // 为移动排序（按启发式得分）
-    std::vector<std::pair<int, std::pair<int, int>>> scoredMoves;
-    for (const auto &move : moves)
+    // 分阶段逐个取着法：置换表着法、成五/挡五、杀手着法、按历史表排序的其余着法
+    Piece other = BoardBits::opponent(side);
+    MovePicker picker = [&]
     {
-        int score = getMoveHeuristicScore(board, move.first, move.second, aiColor, humanColor, boardSize);
-        scoredMoves.push_back({score, move});
-    }
-    
-    // 按得分降序排序（对于最大化方）或升序排序（对于最小化方）
-    if (isMaximizing) {
-        std::sort(scoredMoves.begin(), scoredMoves.end(),
-                  [](const auto &a, const auto &b) { return a.first > b.first; });
-    } else {
-        std::sort(scoredMoves.begin(), scoredMoves.end(),
-                  [](const auto &a, const auto &b) { return a.first < b.first; });
+        ScopedTimer timer(profiling, w.movegenNs);
+        return MovePicker(board, pos.candidates(), side, ttMove, w.killers[ply], w.history[BoardBits::colorIndex(side)], MOVE_LIMIT);
+    }();
+    auto nextMove = [&]
+    {
+        ScopedTimer timer(profiling, w.movegenNs);
+        return picker.next();
+    };
+    int first = nextMove();
+    if (first < 0)
+    {
+        int score = evaluateBoard(pos, aiColor);
+        return side == aiColor ? score : -score;
     }
+    ++w.expanded;
 
-    if (isMaximizing)
+    int bestScore = -SCORE_INF;
+    int bestMove = first;
+    int moveCount = 0;
+    for (int idx = first; idx >= 0; idx = nextMove())
     {
-        int maxEval = INT_MIN;
-        for (const auto &scoredMove : scoredMoves)
+        int x = BoardBits::toX(idx), y = BoardBits::toY(idx);
+
+        // 模拟落子（评估器随之增量更新）
         {
-            const auto &move = scoredMove.second;
-            
-            // 模拟落子
-            board[move.first][move.second] = aiColor;
-            
-            // 检查AI是否获胜
-            if (checkFiveInRow(board, move.first, move.second, aiColor, boardSize)) {
-                board[move.first][move.second] = Piece::EMPTY;
-                return 1000000 - depth; // 获胜，深度越浅得分越高
-            }
-            
-            int eval = minimax(board, depth - 1, false, alpha, beta, aiColor);
-            // 撤销落子
-            board[move.first][move.second] = Piece::EMPTY;
-
-            maxEval = std::max(maxEval, eval);
-            alpha = std::max(alpha, eval);
-            if (beta <= alpha)
-                break; // Alpha-Beta剪枝
+            ScopedTimer timer(profiling, w.evalNs);
+            pos.makeMove(x, y, side);
         }
-        return maxEval;
-    }
-    else
-    {
-        int minEval = INT_MAX;
-        for (const auto &scoredMove : scoredMoves)
+
+        // 走子方成五：越早获胜得分越高
+        if (board.isFive(x, y, side))
         {
-            const auto &move = scoredMove.second;
-            
-            // 模拟落子
-            board[move.first][move.second] = humanColor;
-            
-            // 检查人类是否获胜
-            if (checkFiveInRow(board, move.first, move.second, humanColor, boardSize)) {
-                board[move.first][move.second] = Piece::EMPTY;
-                return -1000000 + depth; // 人类获胜，深度越浅负分越多
-            }
-            
-            int eval = minimax(board, depth - 1, true, alpha, beta, aiColor);
-            // 撤销落子
-            board[move.first][move.second] = Piece::EMPTY;
-
-            minEval = std::min(minEval, eval);
-            beta = std::min(beta, eval);
-            if (beta <= alpha)
-                break; // Alpha-Beta剪枝
+            pos.unmakeMove(x, y);
+            w.searched += moveCount + 1;
+            int score = WIN_SCORE - (ply + 1);
+            tt.store(pos.hash(), depth, TranspositionTable::Bound::Exact, scoreToTT(score, ply), idx);
+            return score;
         }
-        return minEval;
-    }
-}
 
-std::pair<int, int> AiPlayer::getNextMove(const std::vector<std::vector<Piece>> &board)
-{
-    // 如果棋盘为空，返回中心位置
-    bool isEmpty = true;
-    for (int i = 0; i < boardSize && isEmpty; ++i)
-    {
-        for (int j = 0; j < boardSize && isEmpty; ++j)
+        // 第一个着法用完整窗口，其余先用零窗口试探，只有落在窗口内时才重搜
+        int score;
+        if (moveCount == 0)
+        {
+            score = -negamax(w, depth - 1, -beta, -alpha, other);
+        }
+        else
+        {
+            score = -negamax(w, depth - 1, -alpha - 1, -alpha, other);
+            if (score > alpha && score < beta)
+                score = -negamax(w, depth - 1, -beta, -alpha, other);
+        }
+        // 撤销落子
         {
-            if (board[i][j] != Piece::EMPTY)
+            ScopedTimer timer(profiling, w.evalNs);
+            pos.unmakeMove(x, y);
+        }
+        if (stop.load(std::memory_order_relaxed))
+            return 0;
+        ++moveCount;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestMove = idx;
+        }
+        if (score > alpha)
+            alpha = score;
+        if (alpha >= beta)
+        {
+            // 普通着法造成剪枝时记为本层杀手，并按深度平方加历史分
+            if (picker.lastIsQuiet())
             {
-                isEmpty = false;
+                int16_t *killers = w.killers[ply];
+                if (killers[0] != idx)
+                {
+                    killers[1] = killers[0];
+                    killers[0] = static_cast<int16_t>(idx);
+                }
+                w.history[BoardBits::colorIndex(side)][idx] += depth * depth;
             }
+            ++w.cutoffs;
+            if (moveCount == 1)
+                ++w.firstCutoffs;
+            break; // Alpha-Beta剪枝
         }
     }
+    w.searched += moveCount;
+
+    // 按结果与原始窗口的关系确定界类型并写入置换表
+    TranspositionTable::Bound bound = TranspositionTable::Bound::Exact;
+    if (bestScore <= alphaOrig)
+        bound = TranspositionTable::Bound::Upper;
+    else if (bestScore >= beta)
+        bound = TranspositionTable::Bound::Lower;
+    tt.store(pos.hash(), depth, bound, scoreToTT(bestScore, ply), bestMove);
+    return bestScore;
+}
+
+std::pair<int, int> AiPlayer::getNextMove(const BoardView &board)
+{
+    auto start = std::chrono::steady_clock::now();
+    lastStats = SearchStats();
+    std::pair<int, int> move = searchMove(board);
+
+    lastStats.final = true;
+    lastStats.timeMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                            std::chrono::steady_clock::now() - start)
+                                            .count());
+    lastStats.nps = lastStats.nodes * 1000 / std::max(1, lastStats.timeMs);
+    if (lastStats.pv.empty() && move.first >= 0)
+        lastStats.pv.push_back(move);
+    if (statsListener)
+        statsListener(lastStats);
+    return move;
+}
+
+std::pair<int, int> AiPlayer::searchMove(const BoardView &board)
+{
+    // 转换为位棋盘，之后的搜索都在其上原地落子/撤销
+    Bitboard bitboard = Bitboard::fromBoard(board, boardSize);
+
+    // 从这里起的全部用时（含开局库、候选生成与排序）都计入本步，任一路径返回时结算
+    MoveClock clock(timeManager, limits, bitboard.stoneCount());
+
+    // 新一轮搜索：置换表代数前进，旧结果逐渐被替换
+    tt.newSearch();
 
-    if (isEmpty)
+    // 如果棋盘为空，返回中心位置
+    if (bitboard.stoneCount() == 0)
     {
         // 返回棋盘中心
         return {boardSize / 2, boardSize / 2};
     }
 
-    auto moves = getValidMoves(board);
+    // 开局阶段先查开局库，命中则不必搜索
+    if (book.isOpen() && bitboard.stoneCount() < GameConfig::DEFAULT_AI_BOOK_PLIES)
+    {
+        std::pair<int, int> bookMove = book.probe(bitboard);
+        if (bookMove.first >= 0)
+            return bookMove;
+    }
+
+    auto moves = getValidMoves(bitboard);
     if (moves.empty())
     {
         return {-1, -1}; // 没有合法移动
     }
 
-    // 使用改进的极小化极大算法选择最佳移动（深度增加到3以提高AI水平）
-    int bestScore = INT_MIN;
-    std::pair<int, int> bestMove = moves[0];
-
-    // 创建可修改的棋盘副本
-    std::vector<std::vector<Piece>> boardCopy = board;
+    // 搜索局面：位棋盘 + 增量评估器（使用 NNUE 时再挂接网络累加器）
+    Position pos(bitboard);
+    if (evalKind == EvalKind::Nnue)
+        pos.setNetwork(&network);
 
     // 使用贪心算法：先评估所有移动的启发式得分，只搜索最有潜力的几个
+    Piece humanColor = (aiColor == Piece::BLACK) ? Piece::WHITE : Piece::BLACK;
     std::vector<std::pair<int, std::pair<int, int>>> scoredMoves;
     for (const auto &move : moves)
     {
         // 计算启发式得分
-        int aiScore = evaluatePosition(board, move.first, move.second, aiColor, boardSize);
-        Piece humanColor = (aiColor == Piece::BLACK) ? Piece::WHITE : Piece::BLACK;
-        int humanScore = evaluatePosition(board, move.first, move.second, humanColor, boardSize);
-        int heuristicScore = aiScore + humanScore * 2;
-        
+        int heuristicScore = getMoveHeuristicScore(bitboard, move.first, move.second, aiColor, humanColor);
         scoredMoves.push_back({heuristicScore, move});
     }
     
@@ -427,23 +466,249 @@ std::pair<int, int> AiPlayer::getNextMove(const std::vector<std::vector<Piece>>
     
     // 只搜索前8个最有潜力的移动（贪心剪枝）
     int searchLimit = std::min(8, (int)scoredMoves.size());
-    
+    std::vector<std::pair<int, int>> rootMoves;
     for (int i = 0; i < searchLimit; ++i)
     {
-        const auto &move = scoredMoves[i].second;
-        
-        // 模拟落子
-        boardCopy[move.first][move.second] = aiColor;
-        int score = minimax(boardCopy, 3, false, INT_MIN, INT_MAX, aiColor);
-        // 撤销落子
-        boardCopy[move.first][move.second] = Piece::EMPTY;
+        rootMoves.push_back(scoredMoves[i].second);
+    }
 
-        if (score > bestScore)
+    // 能直接成五则无需搜索
+    for (const auto &move : rootMoves)
+    {
+        pos.makeMove(move.first, move.second, aiColor);
+        bool win = pos.board().isFive(move.first, move.second, aiColor);
+        pos.unmakeMove(move.first, move.second);
+        if (win)
+            return move;
+    }
+
+    // 威胁空间搜索预检：先找连续冲四胜（VCF），再找连续活三胜（VCT）；
+    // 两者共用按本步时限折算的节点预算与截止时刻，外部中止也能随时打断
+    int threatMs = std::max(1, timeManager.hardLimit() / THREAT_TIME_SHARE);
+    uint64_t threatBudget = uint64_t(threatMs) * THREAT_NODES_PER_MS;
+    threatSolver.setDeadline(timeManager.deadline(threatMs));
+    threatSolver.setNodeLimit(std::min(VCF_NODES, threatBudget));
+    ThreatSolver::Result threat = threatSolver.solve(bitboard, aiColor, ThreatSolver::Mode::VCF, VCF_DEPTH);
+    if (!threat.win && !abortRequested)
+    {
+        threatSolver.setNodeLimit(std::min(VCT_NODES, threatBudget - std::min(threatBudget, threat.nodes)));
+        ThreatSolver::Result vct = threatSolver.solve(bitboard, aiColor, ThreatSolver::Mode::VCT, VCT_DEPTH);
+        vct.nodes += threat.nodes;
+        vct.cacheProbes += threat.cacheProbes;
+        vct.cacheHits += threat.cacheHits;
+        threat = vct;
+    }
+    lastStats.threatNodes = threat.nodes;
+    lastStats.threatCacheHitRate = ratio(threat.cacheHits, threat.cacheProbes);
+    if (threat.win)
+        return {threat.x, threat.y};
+
+    if (abortRequested)
+        return rootMoves[0];
+
+    // 迭代加深 + Lazy SMP：各线程在同一根节点上独立加深，通过共享置换表互相借力
+    int count = threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    stop = false;
+    sharedNodes = 0;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int i = 0; i < count; ++i)
+        workers.push_back(std::make_unique<Worker>(i, pos));
+
+    std::vector<std::thread> helpers;
+    for (int i = 1; i < count; ++i)
+        helpers.emplace_back([this, &workers, &rootMoves, i]
+                             { searchRoot(*workers[i], rootMoves); });
+    searchRoot(*workers[0], rootMoves);
+    for (auto &t : helpers)
+        t.join();
+
+    // 取完成深度最深的线程的结果，同深度时以主线程为准
+    const Worker *best = workers[0].get();
+    for (const auto &w : workers)
+    {
+        if (w->completedDepth > best->completedDepth)
+            best = w.get();
+    }
+    std::pair<int, int> bestMove = best->completedDepth > 0 ? best->bestMove : rootMoves[0];
+
+    // 主搜索的胜负分可能来自候选剪枝，交给证明数搜索确认；证明成立则走证明中的胜着。
+    // 证明只能使用 hard 期限前剩下的时间，已到期限则跳过
+    int remainingMs = timeManager.hardLimit() - timeManager.elapsed();
+    if (best->completedDepth > 0 && best->bestScore >= HANDOFF_SCORE && !abortRequested && remainingMs > 0)
+    {
+        proofSolver.setNodeLimit(std::min<uint64_t>(GameConfig::DEFAULT_AI_PN_NODES, uint64_t(remainingMs) * PN_NODES_PER_MS));
+        proofSolver.setDeadline(timeManager.deadline(timeManager.hardLimit()));
+        ProofSolver::Result proof = proofSolver.prove(bitboard, aiColor, aiColor);
+        lastStats.threatNodes += proof.nodes;
+        if (proof.status == ProofSolver::Status::Win)
+            bestMove = {proof.x, proof.y};
+    }
+
+    std::vector<const Worker *> finished;
+    for (const auto &w : workers)
+        finished.push_back(w.get());
+    collectStats(finished, lastStats);
+    lastStats.depth = best->completedDepth;
+    lastStats.score = best->bestScore;
+    lastStats.pv = extractPV(pos, bestMove, std::max(1, best->completedDepth));
+
+    uint64_t elapsed = std::max(1, timeManager.elapsed());
+    threadStats.clear();
+    for (const auto &w : workers)
+        threadStats.push_back({w->id, w->nodes, w->completedDepth, w->nodes * 1000 / elapsed});
+
+    return bestMove;
+}
+
+void AiPlayer::collectStats(const std::vector<const Worker *> &workers, SearchStats &stats) const
+{
+    uint64_t expanded = 0, searched = 0, cutoffs = 0, firstCutoffs = 0, ttProbes = 0, ttHits = 0;
+    uint64_t movegenNs = 0, evalNs = 0;
+    for (const Worker *w : workers)
+    {
+        stats.nodes += w->nodes;
+        stats.qnodes += w->qnodes;
+        stats.seldepth = std::max(stats.seldepth, w->seldepth);
+        expanded += w->expanded;
+        searched += w->searched;
+        cutoffs += w->cutoffs;
+        firstCutoffs += w->firstCutoffs;
+        ttProbes += w->ttProbes;
+        ttHits += w->ttHits;
+        movegenNs += w->movegenNs;
+        evalNs += w->evalNs;
+    }
+    stats.firstMoveCutoffRate = ratio(firstCutoffs, cutoffs);
+    stats.ttHitRate = ratio(ttHits, ttProbes);
+    stats.branchingFactor = ratio(searched, expanded);
+    stats.movegenUs = movegenNs / 1000;
+    stats.evalUs = evalNs / 1000;
+}
+
+std::vector<std::pair<int, int>> AiPlayer::extractPV(Position pos, std::pair<int, int> first, int maxLength) const
+{
+    std::vector<std::pair<int, int>> pv;
+    Piece side = aiColor;
+    std::pair<int, int> move = first;
+    while (true)
+    {
+        pv.push_back(move);
+        pos.makeMove(move.first, move.second, side);
+        if (pos.board().isFive(move.first, move.second, side) || (int)pv.size() >= maxLength)
+            break;
+
+        // 沿置换表记录的最佳着法走下去，着法失效（键碰撞）时停止
+        TranspositionTable::Entry entry;
+        if (!tt.probe(pos.hash(), entry) || entry.move < 0)
+            break;
+        move = {BoardBits::toX(entry.move), BoardBits::toY(entry.move)};
+        if (!isInBoard(move.first, move.second) || !pos.board().isEmpty(move.first, move.second))
+            break;
+        side = BoardBits::opponent(side);
+    }
+    return pv;
+}
+
+void AiPlayer::searchRoot(Worker &w, std::vector<std::pair<int, int>> rootMoves)
+{
+    // 辅助线程错开起始深度与根着法顺序，尽量让各线程先探索不同的子树
+    int startDepth = 1;
+    if (w.id > 0)
+    {
+        std::rotate(rootMoves.begin(), rootMoves.begin() + w.id % rootMoves.size(), rootMoves.end());
+        startDepth += w.id & 1;
+    }
+
+    // 每轮用上一轮的最佳着法打头，期限到达时丢弃未完成的一轮
+    Piece humanColor = BoardBits::opponent(aiColor);
+    for (int depth = startDepth; depth <= limits.maxDepth; ++depth)
+    {
+        // 渴望窗口：以上一轮的分数为中心，落在窗口外时向失败一侧放宽后重搜
+        int delta = ASPIRATION_DELTA;
+        int alpha = -SCORE_INF, beta = SCORE_INF;
+        if (w.completedDepth >= ASPIRATION_MIN_DEPTH && std::abs(w.bestScore) < WIN_BOUND)
         {
-            bestScore = score;
-            bestMove = move;
+            alpha = std::max(w.bestScore - delta, -SCORE_INF);
+            beta = std::min(w.bestScore + delta, SCORE_INF);
+        }
+
+        int bestScore = -SCORE_INF;
+        std::pair<int, int> iterationMove = rootMoves[0];
+        while (true)
+        {
+            bestScore = -SCORE_INF;
+            int windowAlpha = alpha;
+            for (size_t i = 0; i < rootMoves.size(); ++i)
+            {
+                const auto &move = rootMoves[i];
+                // 模拟落子
+                w.pos.makeMove(move.first, move.second, aiColor);
+                int score;
+                if (i == 0)
+                {
+                    score = -negamax(w, depth - 1, -beta, -windowAlpha, humanColor);
+                }
+                else
+                {
+                    score = -negamax(w, depth - 1, -windowAlpha - 1, -windowAlpha, humanColor);
+                    if (score > windowAlpha && score < beta)
+                        score = -negamax(w, depth - 1, -beta, -windowAlpha, humanColor);
+                }
+                // 撤销落子
+                w.pos.unmakeMove(move.first, move.second);
+                if (stop.load(std::memory_order_relaxed))
+                    break;
+
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    iterationMove = move;
+                }
+                windowAlpha = std::max(windowAlpha, score);
+                if (windowAlpha >= beta)
+                    break;
+            }
+            if (stop.load(std::memory_order_relaxed))
+                break;
+
+            if (bestScore <= alpha && alpha > -SCORE_INF)
+                alpha = std::max(bestScore - delta, -SCORE_INF);
+            else if (bestScore >= beta && beta < SCORE_INF)
+                beta = std::min(bestScore + delta, SCORE_INF);
+            else
+                break;
+            delta *= 4;
+        }
+
+        if (stop.load(std::memory_order_relaxed))
+            break;
+
+        w.completedDepth = depth;
+        w.bestScore = bestScore;
+        w.bestMove = iterationMove;
+        auto it = std::find(rootMoves.begin(), rootMoves.end(), iterationMove);
+        std::rotate(rootMoves.begin(), it, it + 1);
+
+        // 逐轮统计只含主线程的计数
+        if (w.id == 0 && statsListener && statsPerIteration)
+        {
+            SearchStats stats;
+            collectStats({&w}, stats);
+            stats.depth = depth;
+            stats.score = bestScore;
+            stats.timeMs = timeManager.elapsed();
+            stats.nps = stats.nodes * 1000 / std::max(1, stats.timeMs);
+            stats.pv = extractPV(w.pos, iterationMove, depth);
+            statsListener(stats);
         }
+
+        // 已找到必胜或必败，或剩余时间不足以完成下一轮
+        if (std::abs(bestScore) >= WIN_BOUND || (w.id == 0 && timeManager.softExpired()))
+            break;
     }
 
-    return bestMove;
-}
\ No newline at end of file
+    // 主线程结束即通知辅助线程停止
+    if (w.id == 0)
+        stop = true;
+}
@@ -1,25 +1,102 @@
 #ifndef AIPLAYER_H
 #define AIPLAYER_H
 
+#include "AiEngine.h"
 #include "Game.h"
+#include "Bitboard.h"
+#include "OpeningBook.h"
+#include "Nnue.h"
+#include "Position.h"
+#include "ProofSolver.h"
+#include "SearchTypes.h"
+#include "ThreatSolver.h"
+#include "TimeManager.h"
+#include "TranspositionTable.h"
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <vector>
 #include <utility>
 
-class AiPlayer
+class AiPlayer : public AiEngine
 {
 private:
     Piece aiColor; // AI的棋子颜色
     int boardSize;
+    TranspositionTable tt; // 置换表，跨回合保留
+    SearchLimits limits;
+    TimeManager timeManager;
+    ThreatSolver threatSolver; // VCF/VCT 预检，证明缓存跨回合保留
+    OpeningBook book;          // 开局库（内存映射，可为空）
+    ProofSolver proofSolver;   // 证明数搜索，主搜索发现强制胜时接手
+    NnueNetwork network;       // NNUE 权重（可为空）
+    EvalKind evalKind = EvalKind::Pattern;
 
-    // 评估函数：评估当前棋盘对AI的得分
-    int evaluateBoard(const std::vector<std::vector<Piece>> &board, Piece aiColor) const;
+    static constexpr int MAX_PLY = 64;
+
+    // 单个搜索线程的状态（Lazy SMP：各线程独立的局面、计数与排序表，共享置换表）
+    struct Worker
+    {
+        int id;
+        Position pos;
+        int rootStones;                                 // 根局面的棋子数，用于换算层数
+        int16_t killers[MAX_PLY][2];                    // 每层两个杀手着法
+        int32_t history[2][BoardBits::CELLS] = {};      // 历史表：[走子方][位平面索引]
+        uint64_t nodes = 0;
+        uint64_t qnodes = 0;       // 深度 0 直接评估的叶节点
+        uint64_t expanded = 0;     // 生成过着法的内部节点
+        uint64_t searched = 0;     // 内部节点实际搜索的着法总数
+        uint64_t cutoffs = 0;      // 发生剪枝的节点
+        uint64_t firstCutoffs = 0; // 第一个着法即剪枝的节点
+        uint64_t ttProbes = 0;
+        uint64_t ttHits = 0;
+        uint64_t movegenNs = 0;
+        uint64_t evalNs = 0;
+        int seldepth = 0;
+        int completedDepth = 0;
+        int bestScore = 0;
+        std::pair<int, int> bestMove = {-1, -1};
+
+        Worker(int id, const Position &pos) : id(id), pos(pos), rootStones(pos.board().stoneCount())
+        {
+            for (auto &k : killers)
+                k[0] = k[1] = -1;
+        }
+    };
+
+    int threadCount = GameConfig::DEFAULT_AI_THREADS;
+    std::atomic<bool> stop{false};        // 所有线程共享的中止标志
+    std::atomic<bool> abortRequested{false}; // 外部（其他线程）请求中止
+    std::atomic<uint64_t> sharedNodes{0}; // 所有线程的节点总数（每 1024 个节点汇总一次）
+    std::vector<ThreadStats> threadStats; // 上一步各线程的统计
+    SearchStats lastStats;                // 上一步的搜索统计
+    std::function<void(const SearchStats &)> statsListener;
+    bool statsPerIteration = false;
+    bool profiling = false;               // 是否统计着法生成与评估的用时
+
+    // 评估函数：评估当前棋盘对AI的得分（按 evalKind 读取棋形评估或 NNUE 的增量结果）
+    int evaluateBoard(const Position &pos, Piece aiColor) const;
 
     // 获取所有合法落子位置
-    std::vector<std::pair<int, int>> getValidMoves(const std::vector<std::vector<Piece>> &board) const;
+    std::vector<std::pair<int, int>> getValidMoves(const Bitboard &board) const;
+
+    // 负极大值 PVS（在线程自己的局面上原地落子/撤销），返回 side 方视角的分数
+    int negamax(Worker &w, int depth, int alpha, int beta, Piece side);
 
-    // 极小化极大算法
-    int minimax(std::vector<std::vector<Piece>> &board, int depth, bool isMaximizing, int alpha, int beta, Piece aiColor) const;
+    // 单个线程的根节点迭代加深
+    void searchRoot(Worker &w, std::vector<std::pair<int, int>> rootMoves);
+
+    // getNextMove 的主体，统计写入 lastStats
+    std::pair<int, int> searchMove(const BoardView &board);
+
+    // 把各线程的计数汇总到 stats（不含节点数与用时）
+    void collectStats(const std::vector<const Worker *> &workers, SearchStats &stats) const;
+
+    // 从 first 开始沿置换表的最佳着法取主变例
+    std::vector<std::pair<int, int>> extractPV(Position pos, std::pair<int, int> first, int maxLength) const;
+
+    // 是否应当中止搜索（到达硬期限或节点上限）
+    bool shouldStop();
 
     // 检查位置是否在棋盘范围内
     bool isInBoard(int x, int y) const;
@@ -28,9 +105,32 @@ public:
     AiPlayer(Piece color);
     ~AiPlayer();
 
-    void setBoardSize(int size);
-    std::pair<int, int> getNextMove(const std::vector<std::vector<Piece>> &board);
-    Piece getColor() const;
+    void setBoardSize(int size) override;
+    void setHashSize(int megabytes);
+    // 加载（映射）开局库文件，失败时不使用开局库
+    bool loadBook(const std::string &path);
+    // 加载 NNUE 权重文件；成功后还需 setEvalKind(EvalKind::Nnue) 才会使用
+    bool loadNetwork(const std::string &path);
+    // 选择叶节点评估函数，未加载网络时不能选择 NNUE（返回 false）
+    bool setEvalKind(EvalKind kind);
+    EvalKind getEvalKind() const { return evalKind; }
+    void setSearchLimits(const SearchLimits &searchLimits) override;
+    // 同步棋钟（剩余时间与每步加秒，毫秒）
+    void setClock(int remainingMs, int incrementMs);
+    // 搜索线程数，0 表示使用全部核心
+    void setThreads(int count);
+    const std::vector<ThreadStats> &getThreadStats() const { return threadStats; }
+    const SearchStats &getSearchStats() const { return lastStats; }
+    // 每步结束时回调统计；perIteration 为 true 时每完成一轮迭代也回调（在搜索线程中调用）
+    void setStatsListener(std::function<void(const SearchStats &)> listener, bool perIteration = false);
+    // 统计着法生成与评估的用时（每次计时都有开销，默认关闭）
+    void setProfiling(bool enabled);
+
+    void abortSearch() override;
+    void clearAbort() override;
+    using AiEngine::getNextMove;
+    std::pair<int, int> getNextMove(const BoardView &board) override;
+    Piece getColor() const override;
 };
 
 #endif // AIPLAYER_H
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "AiService.h"
+#include "AiEngine.h"
+
+AiService::AiService(QObject *parent)
+    : QObject(parent),
+      worker(new QObject)
+{
+    worker->moveToThread(&workerThread);
+    connect(&workerThread, &QThread::finished, worker, &QObject::deleteLater);
+    workerThread.setObjectName("AiWorker");
+    workerThread.start();
+}
+
+AiService::~AiService()
+{
+    cancel();
+    workerThread.quit();
+    workerThread.wait();
+}
+
+quint64 AiService::requestMove(AiEngine *ai, const BoardView &board)
+{
+    quint64 id = ++nextRequestId;
+    quint64 gen = generation.load();
+    ++pending;
+
+    // 视图指向 Game 的棋盘，交给工作线程前复制为定长快照
+    BoardSnapshot snapshot(board);
+    QMetaObject::invokeMethod(worker, [this, ai, snapshot, gen, id]
+                              {
+        // 先登记并清除中止标志，再检查代数：与 cancel() 的“先递增代数、再中止”配合，
+        // 保证请求要么在开始前被跳过，要么开始后能被中止
+        running = ai;
+        ai->clearAbort();
+        std::pair<int, int> move = {-1, -1};
+        if (generation.load() == gen)
+            move = ai->getNextMove(snapshot.view());
+        running = nullptr;
+
+        QMetaObject::invokeMethod(this, [this, gen, id, move]
+                                  {
+            --pending;
+            if (generation.load() == gen && move.first >= 0)
+                emit moveReady(id, move.first, move.second); }, Qt::QueuedConnection); }, Qt::QueuedConnection);
+
+    return id;
+}
+
+void AiService::cancel()
+{
+    ++generation;
+    if (AiEngine *ai = running.load())
+        ai->abortSearch();
+}
@@ -0,0 +1,49 @@
+#ifndef AISERVICE_H
+#define AISERVICE_H
+
+#include <QObject>
+#include <QThread>
+#include <atomic>
+#include <vector>
+#include "Game.h"
+
+class AiEngine;
+
+/**
+ * @brief 异步 AI 服务
+ *
+ * 在专用工作线程上调用 AiEngine::getNextMove，结果经排队信号回到 GUI 线程，思考期间界面保持响应。
+ * 请求携带棋盘快照，提交后调用方可以继续修改对局。
+ * cancel() 让正在进行的搜索尽快返回，并丢弃所有尚未送达的结果；对局重置、悔棋、退出房间时调用。
+ * 同一时刻只有一个引擎在工作线程上运行，引擎的生命周期须长于本服务。
+ */
+class AiService : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AiService(QObject *parent = nullptr);
+    ~AiService();
+
+    // 提交一次思考请求，返回请求编号（与 moveReady 中的编号对应）
+    quint64 requestMove(AiEngine *ai, const BoardView &board);
+
+    // 取消所有未完成的请求
+    void cancel();
+
+    bool isThinking() const { return pending > 0; }
+
+signals:
+    // 仅对未被取消的请求发出，位于 GUI 线程
+    void moveReady(quint64 requestId, int x, int y);
+
+private:
+    QThread workerThread;
+    QObject *worker;                        // 工作线程上的事件接收者
+    std::atomic<quint64> generation{0};     // 每次 cancel() 递增，结果代数不符即丢弃
+    std::atomic<AiEngine *> running{nullptr}; // 正在思考的引擎，供 cancel() 中止
+    quint64 nextRequestId = 0;
+    int pending = 0; // 已提交未送达的请求数（仅在 GUI 线程读写）
+};
+
+#endif // AISERVICE_H
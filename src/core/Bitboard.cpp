@@ -0,0 +1,151 @@
+#include "Bitboard.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace BoardBits;
+
+namespace
+{
+    constexpr int SIZE_COUNT = GameConfig::MAX_BOARD_SIZE - GameConfig::MIN_BOARD_SIZE + 1;
+
+    void buildGeometry(BoardGeometry &g, int n)
+    {
+        g.size = n;
+        g.lineCount[0] = n;
+        g.lineCount[1] = n;
+        g.lineCount[2] = 2 * n - 1;
+        g.lineCount[3] = 2 * n - 1;
+
+        for (int x = 0; x < n; ++x)
+        {
+            for (int y = 0; y < n; ++y)
+            {
+                int idx = index(x, y);
+                g.valid.set(idx);
+
+                int lineOf[DIRS] = {y, x, x - y + n - 1, x + y};
+                int posOf[DIRS] = {x, y, std::min(x, y), x - std::max(0, x + y - (n - 1))};
+                for (int d = 0; d < DIRS; ++d)
+                {
+                    g.line[d][idx] = static_cast<uint8_t>(lineOf[d]);
+                    g.pos[d][idx] = static_cast<uint8_t>(posOf[d]);
+                    g.lineMask[d][lineOf[d]] |= 1u << (posOf[d] + LINE_PAD);
+                    g.cell[d][lineOf[d]][posOf[d]] = static_cast<int16_t>(idx);
+                }
+            }
+        }
+    }
+}
+
+const BoardGeometry &BoardGeometry::get(int size)
+{
+    static const std::vector<BoardGeometry> table = []
+    {
+        std::vector<BoardGeometry> t(SIZE_COUNT);
+        for (int i = 0; i < SIZE_COUNT; ++i)
+            buildGeometry(t[i], GameConfig::MIN_BOARD_SIZE + i);
+        return t;
+    }();
+    // 超出支持范围的尺寸按边界处理
+    size = std::clamp(size, GameConfig::MIN_BOARD_SIZE, GameConfig::MAX_BOARD_SIZE);
+    return table[size - GameConfig::MIN_BOARD_SIZE];
+}
+
+Bitboard::Bitboard(int size) : geo(&BoardGeometry::get(size)) {}
+
+Bitboard Bitboard::fromBoard(const BoardView &board, int size)
+{
+    Bitboard bb(size);
+    int n = std::min(bb.size(), board.size());
+    for (int x = 0; x < n; ++x)
+    {
+        for (int y = 0; y < n; ++y)
+        {
+            Piece p = board.at(x, y);
+            if (p != Piece::EMPTY)
+                bb.place(x, y, p);
+        }
+    }
+    return bb;
+}
+
+Bitboard Bitboard::fromBoard(const std::vector<std::vector<Piece>> &board, int size)
+{
+    Bitboard bb(size);
+    int rows = std::min<int>(bb.size(), board.size());
+    for (int x = 0; x < rows; ++x)
+    {
+        int cols = std::min<int>(bb.size(), board[x].size());
+        for (int y = 0; y < cols; ++y)
+        {
+            if (board[x][y] != Piece::EMPTY)
+                bb.place(x, y, board[x][y]);
+        }
+    }
+    return bb;
+}
+
+Piece Bitboard::at(int x, int y) const
+{
+    int idx = index(x, y);
+    if (planes[0].test(idx))
+        return Piece::BLACK;
+    if (planes[1].test(idx))
+        return Piece::WHITE;
+    return Piece::EMPTY;
+}
+
+void Bitboard::place(int x, int y, Piece p)
+{
+    int c = colorIndex(p);
+    int idx = index(x, y);
+    planes[c].set(idx);
+    for (int d = 0; d < DIRS; ++d)
+        lines[c][d][geo->line[d][idx]] |= 1u << (geo->pos[d][idx] + LINE_PAD);
+    ++count;
+}
+
+void Bitboard::remove(int x, int y)
+{
+    int idx = index(x, y);
+    int c = planes[0].test(idx) ? 0 : (planes[1].test(idx) ? 1 : -1);
+    if (c < 0)
+        return;
+    planes[c].reset(idx);
+    for (int d = 0; d < DIRS; ++d)
+        lines[c][d][geo->line[d][idx]] &= ~(1u << (geo->pos[d][idx] + LINE_PAD));
+    --count;
+}
+
+BitPlane Bitboard::neighbours(int radius) const
+{
+    // 先横向、再纵向逐格膨胀；每步都与有效格相与，哨兵列保证不会跨行
+    BitPlane occ = occupied();
+    BitPlane d = occ;
+    for (int r = 0; r < radius; ++r)
+        d = (d | d.shl(1) | d.shr(1)) & geo->valid;
+    for (int r = 0; r < radius; ++r)
+        d = (d | d.shl(STRIDE) | d.shr(STRIDE)) & geo->valid;
+    return d.andNot(occ);
+}
+
+void Bitboard::window(int x, int y, int dir, Piece p, uint32_t &own, uint32_t &block) const
+{
+    int idx = index(x, y);
+    int l = geo->line[dir][idx];
+    int pos = geo->pos[dir][idx];
+    int c = colorIndex(p);
+    // 位 (pos + LINE_PAD + i) 对应线上位置 pos + i，右移 pos 后低 7 位即 pos-3 .. pos+3
+    own = (lines[c][dir][l] >> pos) & 0x7F;
+    block = ((lines[c ^ 1][dir][l] | ~geo->lineMask[dir][l]) >> pos) & 0x7F;
+}
+
+bool Bitboard::isFive(int x, int y, Piece p, WinDetector::Rule rule) const
+{
+    int idx = index(x, y);
+    int c = colorIndex(p);
+    bool five = false;
+    for (int d = 0; d < DIRS; ++d)
+        five |= WinDetector::fiveThrough(lines[c][d][geo->line[d][idx]], geo->pos[d][idx] + LINE_PAD, rule);
+    return five;
+}
@@ -0,0 +1,190 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "Game.h"
+#include "GameConfig.h"
+#include "WinDetector.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief AI 搜索用的紧凑位棋盘
+ *
+ * 位平面采用 x * STRIDE + y 的行主序布局，每行末尾留一列恒为 0 的哨兵，
+ * 因此四个方向的整体移位不会跨行串位；19×20 = 380 位，放进 6 个 64 位字（384 位）。
+ * 除位平面外，还按行、列、两条对角线维护每条线的压缩位串，用于棋形窗口提取与连五检测。
+ */
+namespace BoardBits
+{
+    constexpr int MAX_SIZE = GameConfig::MAX_BOARD_SIZE;
+    constexpr int STRIDE = MAX_SIZE + 1;            // 每行 19 格 + 1 列哨兵
+    constexpr int CELLS = MAX_SIZE * STRIDE;        // 位平面索引上限
+    constexpr int MAX_LINES = 2 * MAX_SIZE - 1;     // 单方向最多的线数（对角线）
+    constexpr int LINE_PAD = 3;                     // 线位串两端预留的位数，便于取 7 格窗口
+    constexpr int DIRS = 4;
+
+    // 方向顺序与评估函数保持一致：垂直、水平、主对角线、副对角线
+    constexpr int DX[DIRS] = {1, 0, 1, 1};
+    constexpr int DY[DIRS] = {0, 1, 1, -1};
+    constexpr int SHIFT[DIRS] = {STRIDE, 1, STRIDE + 1, STRIDE - 1};
+
+    inline int index(int x, int y) { return x * STRIDE + y; }
+    inline int toX(int idx) { return idx / STRIDE; }
+    inline int toY(int idx) { return idx % STRIDE; }
+    inline int colorIndex(Piece p) { return p == Piece::WHITE ? 1 : 0; }
+    inline Piece opponent(Piece p) { return p == Piece::BLACK ? Piece::WHITE : Piece::BLACK; }
+}
+
+/**
+ * @brief 384 位位平面
+ */
+struct BitPlane
+{
+    static constexpr int WORDS = 6;
+    std::array<uint64_t, WORDS> w{};
+
+    bool test(int idx) const { return (w[idx >> 6] >> (idx & 63)) & 1; }
+    void set(int idx) { w[idx >> 6] |= uint64_t(1) << (idx & 63); }
+    void reset(int idx) { w[idx >> 6] &= ~(uint64_t(1) << (idx & 63)); }
+
+    bool any() const
+    {
+        uint64_t r = 0;
+        for (uint64_t v : w)
+            r |= v;
+        return r != 0;
+    }
+
+    int count() const
+    {
+        int c = 0;
+        for (uint64_t v : w)
+            c += __builtin_popcountll(v);
+        return c;
+    }
+
+    BitPlane operator|(const BitPlane &o) const
+    {
+        BitPlane r;
+        for (int i = 0; i < WORDS; ++i)
+            r.w[i] = w[i] | o.w[i];
+        return r;
+    }
+
+    BitPlane operator&(const BitPlane &o) const
+    {
+        BitPlane r;
+        for (int i = 0; i < WORDS; ++i)
+            r.w[i] = w[i] & o.w[i];
+        return r;
+    }
+
+    // this & ~o
+    BitPlane andNot(const BitPlane &o) const
+    {
+        BitPlane r;
+        for (int i = 0; i < WORDS; ++i)
+            r.w[i] = w[i] & ~o.w[i];
+        return r;
+    }
+
+    // 向高位移动 n 位（0 < n < 64）
+    BitPlane shl(int n) const
+    {
+        BitPlane r;
+        for (int i = WORDS - 1; i > 0; --i)
+            r.w[i] = (w[i] << n) | (w[i - 1] >> (64 - n));
+        r.w[0] = w[0] << n;
+        return r;
+    }
+
+    // 向低位移动 n 位（0 < n < 64）
+    BitPlane shr(int n) const
+    {
+        BitPlane r;
+        for (int i = 0; i < WORDS - 1; ++i)
+            r.w[i] = (w[i] >> n) | (w[i + 1] << (64 - n));
+        r.w[WORDS - 1] = w[WORDS - 1] >> n;
+        return r;
+    }
+
+    // 按索引升序遍历所有置位
+    template <typename F>
+    void forEach(F &&f) const
+    {
+        for (int i = 0; i < WORDS; ++i)
+        {
+            uint64_t v = w[i];
+            while (v)
+            {
+                f(i * 64 + __builtin_ctzll(v));
+                v &= v - 1;
+            }
+        }
+    }
+};
+
+/**
+ * @brief 某一棋盘尺寸下的预计算几何表
+ *
+ * 为 MIN_BOARD_SIZE ~ MAX_BOARD_SIZE 的每个尺寸各生成一份，首次使用时构建。
+ */
+struct BoardGeometry
+{
+    int size = 0;
+    BitPlane valid;                                           // 棋盘内格子
+    int lineCount[BoardBits::DIRS] = {};                      // 各方向线数
+    uint8_t line[BoardBits::DIRS][BoardBits::CELLS] = {};     // 格子所在线编号
+    uint8_t pos[BoardBits::DIRS][BoardBits::CELLS] = {};      // 格子在线上的位置
+    uint32_t lineMask[BoardBits::DIRS][BoardBits::MAX_LINES] = {}; // 线上有效位（已左移 LINE_PAD）
+    int16_t cell[BoardBits::DIRS][BoardBits::MAX_LINES][BoardBits::MAX_SIZE] = {}; // (线, 位置) -> 位平面索引
+
+    static const BoardGeometry &get(int size);
+};
+
+class Bitboard
+{
+public:
+    explicit Bitboard(int size = GameConfig::DEFAULT_BOARD_SIZE);
+
+    static Bitboard fromBoard(const BoardView &board, int size);
+    static Bitboard fromBoard(const std::vector<std::vector<Piece>> &board, int size);
+
+    int size() const { return geo->size; }
+    const BoardGeometry &geometry() const { return *geo; }
+    bool inBoard(int x, int y) const { return x >= 0 && x < geo->size && y >= 0 && y < geo->size; }
+
+    Piece at(int x, int y) const;
+    bool isEmpty(int x, int y) const { return !occupied().test(BoardBits::index(x, y)); }
+    int stoneCount() const { return count; }
+
+    void place(int x, int y, Piece p);
+    void remove(int x, int y);
+
+    const BitPlane &stones(Piece p) const { return planes[BoardBits::colorIndex(p)]; }
+    BitPlane occupied() const { return planes[0] | planes[1]; }
+    BitPlane empties() const { return geo->valid.andNot(occupied()); }
+
+    // 第 color 方在 dir 方向第 line 条线上的位串（位 pos + LINE_PAD 对应线上位置 pos）
+    uint32_t lineWord(int color, int dir, int line) const { return lines[color][dir][line]; }
+    // dir 方向全部线位串（按线编号排列），供向量内核按下标收集
+    const uint32_t *lineWords(int color, int dir) const { return lines[color][dir]; }
+
+    // 与已有棋子切比雪夫距离不超过 radius 的空位
+    BitPlane neighbours(int radius) const;
+
+    // 以 (x, y) 为中心沿 dir 方向的 7 格窗口：own 为 p 方棋子，block 为对方棋子与界外
+    void window(int x, int y, int dir, Piece p, uint32_t &own, uint32_t &block) const;
+
+    // 过 (x, y) 的四条线上，p 方是否存在覆盖该点的五连（rule 为 Exact 时长连不算）
+    bool isFive(int x, int y, Piece p, WinDetector::Rule rule = WinDetector::Rule::Freestyle) const;
+
+private:
+    const BoardGeometry *geo;
+    BitPlane planes[2];
+    uint32_t lines[2][BoardBits::DIRS][BoardBits::MAX_LINES] = {};
+    int count = 0;
+};
+
+#endif // BITBOARD_H
@@ -0,0 +1,39 @@
+#include "CandidateSet.h"
+#include <algorithm>
+#include <iterator>
+
+using namespace BoardBits;
+
+void CandidateSet::init(const Bitboard &board)
+{
+    std::fill(std::begin(refs), std::end(refs), 0);
+    nearby = BitPlane();
+    board.occupied().forEach([&](int idx)
+                             { update(board, toX(idx), toY(idx), 1); });
+}
+
+void CandidateSet::onPlace(const Bitboard &board, int x, int y)
+{
+    update(board, x, y, 1);
+}
+
+void CandidateSet::onRemove(const Bitboard &board, int x, int y)
+{
+    update(board, x, y, -1);
+}
+
+void CandidateSet::update(const Bitboard &board, int x, int y, int delta)
+{
+    for (int i = std::max(0, x - RADIUS); i <= std::min(board.size() - 1, x + RADIUS); ++i)
+    {
+        for (int j = std::max(0, y - RADIUS); j <= std::min(board.size() - 1, y + RADIUS); ++j)
+        {
+            int idx = index(i, j);
+            refs[idx] = static_cast<uint8_t>(refs[idx] + delta);
+            if (refs[idx])
+                nearby.set(idx);
+            else
+                nearby.reset(idx);
+        }
+    }
+}
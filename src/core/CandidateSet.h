@@ -0,0 +1,39 @@
+#ifndef CANDIDATESET_H
+#define CANDIDATESET_H
+
+#include "Bitboard.h"
+#include <cstdint>
+
+/**
+ * @brief 增量维护的候选落子集合
+ *
+ * 对每个格子记录其周围 5×5 范围内（切比雪夫距离不超过 RADIUS）的棋子数，
+ * 计数非零的格子构成已有棋子的膨胀区域，去掉已占用格子即为候选点。
+ * 每次落子/提子只更新 25 个格子的计数，候选点的位平面随时可直接遍历，
+ * 不必在搜索的每个节点重新做整盘膨胀。
+ * 调用方须在 Bitboard 变更之后调用 onPlace / onRemove。
+ */
+class CandidateSet
+{
+public:
+    static constexpr int RADIUS = 2;
+
+    CandidateSet() = default;
+
+    // 从零统计整个棋盘
+    void init(const Bitboard &board);
+
+    void onPlace(const Bitboard &board, int x, int y);
+    void onRemove(const Bitboard &board, int x, int y);
+
+    // 与已有棋子距离不超过 RADIUS 的空位（等价于 board.neighbours(RADIUS)）
+    BitPlane moves(const Bitboard &board) const { return nearby.andNot(board.occupied()); }
+
+private:
+    void update(const Bitboard &board, int x, int y, int delta);
+
+    uint8_t refs[BoardBits::CELLS] = {}; // 周围的棋子数
+    BitPlane nearby;                     // refs 非零的格子
+};
+
+#endif // CANDIDATESET_H
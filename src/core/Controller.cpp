@@ -319,6 +319,7 @@ void Controller::onSyncGame()
         return;
 
     Packet packet(sessionId, MsgType::SyncGame);
+    packet.AddParam("binary", true); // 声明支持二进制记录，服务器可改用 record 字段回复
     sendPacket(packet);
 }
 
@@ -588,6 +589,13 @@ void Controller::handlePacket(const Packet &packet)
     }
     case MsgType::SyncGame:
     {
+        // 新协议在 record 字段携带二进制记录，旧服务器仍发 statusStr 文本
+        std::vector<uint8_t> record = packet.GetParam<std::vector<uint8_t>>("record");
+        if (!record.empty())
+        {
+            emit syncGameRecord(QByteArray(reinterpret_cast<const char *>(record.data()), static_cast<int>(record.size())));
+            break;
+        }
         std::string statusStr = packet.GetParam<std::string>("statusStr", "");
         // 根据协议，statusStr包含配置和行棋历史
         // 这里可以解析statusStr并发出相应的信号
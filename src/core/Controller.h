@@ -2,6 +2,7 @@
 #define MANAGER_H
 
 #include <QObject>
+#include <QByteArray>
 #include <QThread>
 #include <QMainWindow>
 #include <QStackedWidget>
@@ -88,6 +89,7 @@ signals:
     void draw(NegStatus status);
     void undoMove(NegStatus status);
     void syncGame(const QString &statusStr);
+    void syncGameRecord(const QByteArray &record); // 二进制对局记录，见 GameRecord.h
 
     // Else
     void switchWidget(int index); // 切换界面
@@ -0,0 +1,41 @@
+#include "CpuFeatures.h"
+
+#if defined(GOMOKU_X86) && defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace
+{
+    bool detectAvx2()
+    {
+#if !defined(GOMOKU_X86)
+        return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        // 操作系统须保存 YMM 寄存器状态
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+            return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+}
+
+namespace CpuFeatures
+{
+    bool hasAvx2()
+    {
+        static const bool supported = detectAvx2();
+        return supported;
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef CPUFEATURES_H
+#define CPUFEATURES_H
+
+/**
+ * @brief 运行时 CPU 特性检测
+ *
+ * 向量内核用编译器的 target 属性单独编译，工程本身不加 -mavx2 之类的选项，
+ * 调用前由这里判断当前 CPU（及操作系统）是否支持。结果在首次调用时缓存。
+ */
+namespace CpuFeatures
+{
+    bool hasAvx2();
+}
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define GOMOKU_X86 1
+#endif
+
+// 标记单个函数按 AVX2 编译（MSVC 无需标记即可使用 AVX2 内建函数）
+#if defined(GOMOKU_X86) && (defined(__GNUC__) || defined(__clang__))
+#define GOMOKU_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define GOMOKU_TARGET_AVX2
+#endif
+
+#endif // CPUFEATURES_H
@@ -0,0 +1,42 @@
+// 由 tools/tuner 生成，请勿手工修改；重新调参后用 gomoku-tuner tune --header 覆盖本文件
+#ifndef EVALWEIGHTS_H
+#define EVALWEIGHTS_H
+
+/**
+ * @brief 评估权重
+ *
+ * 局面分 = 己方棋形分 × OWN_WEIGHT / EVAL_SCALE - 对方棋形分 × OPP_WEIGHT / EVAL_SCALE + 位置分差，
+ * 位置分为每颗子的（棋盘边长 - 到中心的曼哈顿距离）× CENTER_WEIGHT；
+ * 落子启发式 = 己方棋形分 + 对方棋形分 × DEFENSE_WEIGHT。
+ */
+namespace EvalWeights
+{
+    constexpr int PATTERN_COUNT = 15;
+
+    // 棋形分，顺序与 PatternTable 的棋形表一致
+    constexpr int PATTERN_SCORES[PATTERN_COUNT] = {
+        1000000, // 11111
+        10000,   // 011110
+        1000,    // 011112
+        1000,    // 211110
+        1000,    // 01110
+        100,     // 01112
+        100,     // 21110
+        500,     // 0011100
+        300,     // 010110
+        300,     // 011010
+        50,      // 001100
+        10,      // 001120
+        10,      // 021100
+        30,      // 01010
+        20,      // 0010100
+    };
+
+    constexpr int EVAL_SCALE = 1000;
+    constexpr int OWN_WEIGHT = 100;
+    constexpr int OPP_WEIGHT = 200;
+    constexpr int CENTER_WEIGHT = 2;
+    constexpr int DEFENSE_WEIGHT = 2;
+}
+
+#endif // EVALWEIGHTS_H
@@ -0,0 +1,124 @@
+#include "Evaluator.h"
+#include "EvalWeights.h"
+#include "PatternTable.h"
+#include "SearchTypes.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace BoardBits;
+
+void Evaluator::init(const Bitboard &board)
+{
+    const BoardGeometry &geo = board.geometry();
+    for (int c = 0; c < 2; ++c)
+    {
+        patterns[c] = 0;
+        positional[c] = 0;
+        for (int d = 0; d < DIRS; ++d)
+        {
+            for (int l = 0; l < geo.lineCount[d]; ++l)
+            {
+                lineScore[c][d][l] = scoreLine(board, c, d, l);
+                patterns[c] += lineScore[c][d][l];
+            }
+        }
+    }
+    for (Piece p : {Piece::BLACK, Piece::WHITE})
+    {
+        board.stones(p).forEach([&](int idx)
+                                { positional[colorIndex(p)] += centerWeight(board, toX(idx), toY(idx)); });
+    }
+}
+
+void Evaluator::onPlace(const Bitboard &board, int x, int y, Piece p)
+{
+    positional[colorIndex(p)] += centerWeight(board, x, y);
+    rescoreLines(board, x, y);
+}
+
+void Evaluator::onRemove(const Bitboard &board, int x, int y, Piece p)
+{
+    positional[colorIndex(p)] -= centerWeight(board, x, y);
+    rescoreLines(board, x, y);
+}
+
+int Evaluator::evaluate(Piece side) const
+{
+    int s = colorIndex(side);
+    int o = s ^ 1;
+    // 同一棋形会被其中每颗子各算一次，故按比例缩小；对方威胁的权重更高（防守更重要）
+    using namespace EvalWeights;
+    int64_t score = int64_t(patterns[s]) * OWN_WEIGHT / EVAL_SCALE - int64_t(patterns[o]) * OPP_WEIGHT / EVAL_SCALE +
+                    positional[s] - positional[o];
+    // 调参生成的权重没有上限，夹到静态分的合法范围内，免得被搜索当成已证明的胜负
+    return static_cast<int>(std::clamp<int64_t>(score, -(WIN_BOUND - 1), WIN_BOUND - 1));
+}
+
+void Evaluator::rescoreLines(const Bitboard &board, int x, int y)
+{
+    const BoardGeometry &geo = board.geometry();
+    int idx = index(x, y);
+    for (int d = 0; d < DIRS; ++d)
+    {
+        int l = geo.line[d][idx];
+        for (int c = 0; c < 2; ++c)
+        {
+            int score = scoreLine(board, c, d, l);
+            patterns[c] += score - lineScore[c][d][l];
+            lineScore[c][d][l] = score;
+        }
+    }
+}
+
+int Evaluator::scoreLine(const Bitboard &board, int color, int dir, int line) const
+{
+    static const PatternTable &table = PatternTable::instance();
+    uint32_t own = board.lineWord(color, dir, line);
+    uint32_t block = board.lineWord(color ^ 1, dir, line) | ~board.geometry().lineMask[dir][line];
+
+    // 线上每颗 color 方棋子以自身为中心取 7 格窗口
+    int score = 0;
+    for (uint32_t bits = own; bits; bits &= bits - 1)
+    {
+        int pos = __builtin_ctz(bits) - LINE_PAD;
+        score += table.score(table.encode((own >> pos) & 0x7F, (block >> pos) & 0x7F));
+    }
+    return score;
+}
+
+int Evaluator::centerWeight(const Bitboard &board, int x, int y)
+{
+    return centerBonus(board, x, y) * EvalWeights::CENTER_WEIGHT;
+}
+
+int Evaluator::centerBonus(const Bitboard &board, int x, int y)
+{
+    // 越靠近中心得分越高
+    int center = board.size() / 2;
+    int distance = std::abs(x - center) + std::abs(y - center);
+    return board.size() - distance;
+}
+
+void Evaluator::countPatterns(const Bitboard &board, int color, int *counts)
+{
+    static const PatternTable &table = PatternTable::instance();
+    const BoardGeometry &geo = board.geometry();
+    for (int i = 0; i < PatternTable::PATTERNS; ++i)
+        counts[i] = 0;
+    // 与 scoreLine 相同的窗口划分，只是按棋形分别计数
+    for (int d = 0; d < DIRS; ++d)
+    {
+        for (int l = 0; l < geo.lineCount[d]; ++l)
+        {
+            uint32_t own = board.lineWord(color, d, l);
+            uint32_t block = board.lineWord(color ^ 1, d, l) | ~geo.lineMask[d][l];
+            for (uint32_t bits = own; bits; bits &= bits - 1)
+            {
+                int pos = __builtin_ctz(bits) - LINE_PAD;
+                uint16_t mask = table.matches(table.encode((own >> pos) & 0x7F, (block >> pos) & 0x7F));
+                for (; mask; mask &= mask - 1)
+                    ++counts[__builtin_ctz(mask)];
+            }
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include "Bitboard.h"
+
+/**
+ * @brief 增量局面评估器
+ *
+ * 对每颗棋子按四个方向的 7 格窗口查棋形表计分，并按线缓存得分。
+ * 一步落子/提子只会改变经过该点的四条线上的窗口，因此每次只重算这四条线，
+ * 同时维护双方棋形总分与中心位置分，叶子评估变为 O(1)。
+ * 调用方须在 Bitboard 变更之后调用 onPlace / onRemove。
+ */
+class Evaluator
+{
+public:
+    Evaluator() = default;
+
+    // 从零计算整个棋盘
+    void init(const Bitboard &board);
+
+    void onPlace(const Bitboard &board, int x, int y, Piece p);
+    void onRemove(const Bitboard &board, int x, int y, Piece p);
+
+    int patternTotal(Piece p) const { return patterns[BoardBits::colorIndex(p)]; }
+    int positionalTotal(Piece p) const { return positional[BoardBits::colorIndex(p)]; }
+
+    // 从 side 方视角的局面分
+    int evaluate(Piece side) const;
+
+    // 离线调参用：color 方每个棋形的命中次数（counts 长度为 PatternTable::PATTERNS），
+    // 以及不乘权重的位置分
+    static void countPatterns(const Bitboard &board, int color, int *counts);
+    static int centerBonus(const Bitboard &board, int x, int y);
+
+private:
+    void rescoreLines(const Bitboard &board, int x, int y);
+    int scoreLine(const Bitboard &board, int color, int dir, int line) const;
+    static int centerWeight(const Bitboard &board, int x, int y);
+
+    int lineScore[2][BoardBits::DIRS][BoardBits::MAX_LINES] = {};
+    int patterns[2] = {};
+    int positional[2] = {};
+};
+
+#endif // EVALUATOR_H
@@ -1,36 +1,99 @@
 #include "Game.h"
+#include "GameRecord.h"
+#include <algorithm>
+#include <cstdlib>
 #include <sstream>
 #include <vector>
 
+namespace
+{
+    // 读一个十进制整数并跳过紧随其后的分隔符 sep（位于结尾时可省略分隔符）
+    bool readField(const char *&p, char sep, int &value)
+    {
+        char *end = nullptr;
+        long v = std::strtol(p, &end, 10);
+        if (end == p || (*end != sep && *end != '\0'))
+            return false;
+        value = static_cast<int>(v);
+        p = *end ? end + 1 : end;
+        return true;
+    }
+}
+
+std::vector<std::vector<Piece>> BoardView::toRows() const
+{
+    std::vector<std::vector<Piece>> rows(n, std::vector<Piece>(n, Piece::EMPTY));
+    for (int x = 0; x < n; ++x)
+        for (int y = 0; y < n; ++y)
+            rows[x][y] = at(x, y);
+    return rows;
+}
+
+BoardSnapshot::BoardSnapshot(const BoardView &view) : n(std::min(view.size(), GameConfig::MAX_BOARD_SIZE))
+{
+    std::copy(view.data(), view.data() + n * n, cells.begin());
+}
+
+BoardSnapshot BoardSnapshot::fromRows(const std::vector<std::vector<Piece>> &rows)
+{
+    BoardSnapshot snapshot;
+    snapshot.n = std::min<int>(rows.size(), GameConfig::MAX_BOARD_SIZE);
+    for (int x = 0; x < snapshot.n; ++x)
+    {
+        int cols = std::min<int>(rows[x].size(), snapshot.n);
+        for (int y = 0; y < cols; ++y)
+            snapshot.cells[x * snapshot.n + y] = static_cast<uint8_t>(rows[x][y]);
+    }
+    return snapshot;
+}
+
 void Game::reset()
 {
-    board.assign(size, std::vector<Piece>(size, Piece::EMPTY));
+    // 同步可能采用过其他尺寸，新对局回到默认棋盘
+    size = GameConfig::DEFAULT_BOARD_SIZE;
+    board.fill(static_cast<uint8_t>(Piece::EMPTY));
+    lines.clear();
     history.clear();
+    snapshots.clear();
+    cursor = 0;
     currPlayer = Piece::BLACK;
     status = Status::Idle;
+    emitChange(BoardChange::Kind::Reset, -1, -1, Piece::EMPTY);
     emitUpdate();
 }
 
 bool Game::move(int x, int y)
 {
-    if (status != Status::Active || x < 0 || x >= size || y < 0 || y >= size || board[x][y] != Piece::EMPTY)
+    if (status != Status::Active || x < 0 || x >= size || y < 0 || y >= size || at(x, y) != Piece::EMPTY)
         return false;
+    // 复盘到中途再落子：从当前局面另起分支
+    truncateHistory(cursor);
+
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastMoveAt).count();
+    lastMoveAt = now;
 
     Piece p = currPlayer;
-    board[x][y] = p;
-    history.push_back({x, y, p});
+    board[x * size + y] = static_cast<uint8_t>(p);
+    lines.set(x, y, p == Piece::WHITE ? 1 : 0);
+    history.push_back({x, y, p, static_cast<uint32_t>(elapsed)});
+    if (history.size() % SNAPSHOT_INTERVAL == 0)
+        snapshots.push_back(board);
+    cursor = moveCount();
 
     if (checkWin(x, y, p) && isLocal)
     {
         status = Status::Settled;
+        emitChange(BoardChange::Kind::Place, x, y, p);
         if (onBoardChanged)
-            onBoardChanged(board);
+            onBoardChanged(getBoardView());
         if (onGameEnded)
             onGameEnded(p == Piece::BLACK ? "黑方胜" : "白方胜");
     }
     else
     {
         currPlayer = (p == Piece::BLACK) ? Piece::WHITE : Piece::BLACK;
+        emitChange(BoardChange::Kind::Place, x, y, p);
         emitUpdate();
     }
     return true;
@@ -38,14 +101,21 @@ bool Game::move(int x, int y)
 
 bool Game::undo()
 {
+    truncateHistory(cursor);
     if (history.empty())
         return false;
 
-    auto &last = history.back();
-    board[last.x][last.y] = Piece::EMPTY;
+    Step last = history.back();
+    board[last.x * size + last.y] = static_cast<uint8_t>(Piece::EMPTY);
+    lines.reset(last.x, last.y, last.p == Piece::WHITE ? 1 : 0);
     history.pop_back();
+    if (snapshots.size() > history.size() / SNAPSHOT_INTERVAL)
+        snapshots.pop_back();
+    cursor = moveCount();
     currPlayer = (currPlayer == Piece::BLACK) ? Piece::WHITE : Piece::BLACK;
-    onBoardChanged(board);
+    emitChange(BoardChange::Kind::Remove, last.x, last.y, last.p);
+    if (onBoardChanged)
+        onBoardChanged(getBoardView());
     return true;
 }
 
@@ -53,49 +123,75 @@ bool Game::sync(const std::string &data)
 {
     if (data.empty())
         return false;
+    if (GameRecord::isRecord(reinterpret_cast<const uint8_t *>(data.data()), data.size()))
+        return syncRecord(reinterpret_cast<const uint8_t *>(data.data()), data.size());
 
     // 尝试解析并恢复状态
-    // deserialize 内部已包含 reset() 和 history 重放
+    // deserialize 内部静默重放，并已发出一次整盘通知
     if (deserialize(data))
     {
-        // 同步成功后，确保 UI 得到最新的完整状态通知
-        emitUpdate();
-
-        // 如果同步后的历史记录显示游戏已结束，需更新状态
-        if (!history.empty())
-        {
-            auto &last = history.back();
-            if (checkWin(last.x, last.y, last.p))
-            {
-                status = Status::Settled;
-                if (onGameEnded)
-                    onGameEnded(last.p == Piece::BLACK ? "黑方胜" : "白方胜");
-            }
-        }
+        settleIfWon();
         return true;
     }
     return false;
 }
 
-bool Game::checkWin(int x, int y, Piece p) const
+bool Game::syncRecord(const uint8_t *data, size_t length)
 {
-    static const int dirs[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
-    for (auto &d : dirs)
+    // deserializeRecord 已发出整盘通知
+    if (!deserializeRecord(data, length))
+        return false;
+    settleIfWon();
+    return true;
+}
+
+void Game::settleIfWon()
+{
+    // 如果同步后的历史记录显示游戏已结束，需更新状态
+    if (history.empty())
+        return;
+    auto &last = history.back();
+    if (checkWin(last.x, last.y, last.p))
     {
-        int count = 1;
-        for (int side : {1, -1})
-        {
-            for (int s = 1; s < 5; ++s)
-            {
-                int nx = x + d[0] * s * side, ny = y + d[1] * s * side;
-                if (nx < 0 || nx >= size || ny < 0 || ny >= size || board[nx][ny] != p)
-                    break;
-                if (++count >= 5)
-                    return true;
-            }
-        }
+        status = Status::Settled;
+        if (onGameEnded)
+            onGameEnded(last.p == Piece::BLACK ? "黑方胜" : "白方胜");
     }
-    return false;
+}
+
+void Game::emitChange(BoardChange::Kind kind, int x, int y, Piece p)
+{
+    BoardChange change;
+    change.kind = kind;
+    change.x = x;
+    change.y = y;
+    change.piece = p;
+    change.moveIndex = cursor;
+    change.toMove = currPlayer;
+    if (batching)
+        pending.push_back(change);
+    else if (onBoardChange)
+        onBoardChange(change);
+}
+
+void Game::endBatch()
+{
+    batching = false;
+    if (onBoardChangeBatch)
+    {
+        onBoardChangeBatch(pending);
+    }
+    else if (onBoardChange)
+    {
+        for (const BoardChange &change : pending)
+            onBoardChange(change);
+    }
+    pending.clear();
+}
+
+bool Game::checkWin(int x, int y, Piece p) const
+{
+    return lines.isFive(x, y, p == Piece::WHITE ? 1 : 0, winRule);
 }
 
 // 序列化格式: version:1;size:15||0,9,8;1,10,10;...
@@ -122,35 +218,163 @@ bool Game::deserialize(const std::string &data)
     if (sep == std::string::npos)
         return false;
 
-    // 解析配置（示例简化处理，可扩展）
-    std::string config = data.substr(0, sep);
-    if (config.find("s:15") != std::string::npos)
-        this->size = 15;
+    // 配置部分："v:1;s:15"，缺省为 15 路
+    int n = GameConfig::DEFAULT_BOARD_SIZE;
+    auto sizePos = data.rfind("s:", sep);
+    if (sizePos != std::string::npos)
+        n = static_cast<int>(std::strtol(data.c_str() + sizePos + 2, nullptr, 10));
 
-    // 重置状态准备重放
-    reset();
+    // 着法部分："p,x,y;p,x,y;..."，颜色由黑先交替决定，p 只作兼容保留
+    std::vector<Step> steps;
+    const char *p = data.c_str() + sep + 2;
+    while (*p)
+    {
+        Step step{};
+        int piece;
+        if (!readField(p, ',', piece) || !readField(p, ',', step.x) || !readField(p, ';', step.y))
+            return false;
+        steps.push_back(step);
+    }
+    return replay(n, steps);
+}
 
-    std::string moves = data.substr(sep + 2);
-    if (moves.empty())
-        return true;
+size_t Game::encodeRecord(uint8_t *buffer, size_t capacity, bool withClock) const
+{
+    GameRecord::Encoder encoder(buffer, capacity, size, static_cast<int>(history.size()), withClock);
+    for (const Step &s : history)
+    {
+        if (!encoder.add(s.x, s.y, s.clockMs))
+            return 0;
+    }
+    return encoder.finish();
+}
+
+std::vector<uint8_t> Game::serializeRecord(bool withClock) const
+{
+    std::vector<uint8_t> out(GameRecord::maxSize(size, static_cast<int>(history.size()), withClock));
+    out.resize(encodeRecord(out.data(), out.size(), withClock));
+    return out;
+}
+
+bool Game::deserializeRecord(const uint8_t *data, size_t length)
+{
+    GameRecord::Decoder decoder(data, length);
+    if (!decoder.valid())
+        return false;
+    std::vector<Step> steps(decoder.moveCount());
+    for (Step &step : steps)
+    {
+        if (!decoder.next(step.x, step.y, step.clockMs))
+            return false;
+    }
+    return replay(decoder.boardSize(), steps);
+}
 
-    std::stringstream ss(moves);
-    std::string item;
-    while (std::getline(ss, item, ';'))
+bool Game::replay(int boardSize, const std::vector<Step> &steps)
+{
+    if (boardSize < GameConfig::MIN_BOARD_SIZE || boardSize > GameConfig::MAX_BOARD_SIZE)
+        return false;
+    Cells occupied{};
+    for (const Step &s : steps)
     {
-        std::stringstream is(item);
-        std::string p_str, x_str, y_str;
+        if (s.x < 0 || s.x >= boardSize || s.y < 0 || s.y >= boardSize || occupied[s.x * boardSize + s.y])
+            return false;
+        occupied[s.x * boardSize + s.y] = 1;
+    }
 
-        if (std::getline(is, p_str, ',') &&
-            std::getline(is, x_str, ',') &&
-            std::getline(is, y_str, ','))
-        {
+    beginBatch();
+    size = boardSize;
+    board.fill(static_cast<uint8_t>(Piece::EMPTY));
+    lines.clear();
+    history.clear();
+    history.reserve(steps.size());
+    snapshots.clear();
+    cursor = 0;
+    currPlayer = Piece::BLACK;
+    status = Status::Active;
+    emitChange(BoardChange::Kind::Reset, -1, -1, Piece::EMPTY);
+    for (const Step &s : steps)
+    {
+        Piece p = currPlayer;
+        board[s.x * size + s.y] = static_cast<uint8_t>(p);
+        lines.set(s.x, s.y, p == Piece::WHITE ? 1 : 0);
+        history.push_back({s.x, s.y, p, s.clockMs});
+        if (history.size() % SNAPSHOT_INTERVAL == 0)
+            snapshots.push_back(board);
+        currPlayer = (p == Piece::BLACK) ? Piece::WHITE : Piece::BLACK;
+        cursor = moveCount();
+        emitChange(BoardChange::Kind::Place, s.x, s.y, p);
+    }
+    endBatch();
+    lastMoveAt = std::chrono::steady_clock::now();
+    emitUpdate();
+    return true;
+}
+
+Game::Cells Game::cellsAt(int ply) const
+{
+    int k = ply / SNAPSHOT_INTERVAL;
+    Cells cells = k ? snapshots[k - 1] : Cells{};
+    for (int i = k * SNAPSHOT_INTERVAL; i < ply; ++i)
+        cells[history[i].x * size + history[i].y] = static_cast<uint8_t>(history[i].p);
+    return cells;
+}
+
+BoardSnapshot Game::boardAt(int ply) const
+{
+    ply = std::max(0, std::min(ply, moveCount()));
+    Cells cells = cellsAt(ply);
+    return BoardSnapshot(BoardView(cells.data(), size));
+}
+
+bool Game::seek(int ply)
+{
+    if (ply < 0 || ply > moveCount())
+        return false;
 
-            int p_idx = std::stoi(p_str);
-            int x = std::stoi(x_str);
-            int y = std::stoi(y_str);
-            move(x, y);
+    // history 保持不变；棋盘按目标局面逐格比对，只对不同的格子发增量事件
+    Cells target = cellsAt(ply);
+    beginBatch();
+    cursor = ply;
+    currPlayer = (ply % 2 == 0) ? Piece::BLACK : Piece::WHITE;
+    for (int x = 0; x < size; ++x)
+    {
+        for (int y = 0; y < size; ++y)
+        {
+            Piece from = at(x, y);
+            Piece to = static_cast<Piece>(target[x * size + y]);
+            if (from == to)
+                continue;
+            board[x * size + y] = static_cast<uint8_t>(to);
+            if (from != Piece::EMPTY)
+            {
+                lines.reset(x, y, from == Piece::WHITE ? 1 : 0);
+                emitChange(BoardChange::Kind::Remove, x, y, from);
+            }
+            if (to != Piece::EMPTY)
+            {
+                lines.set(x, y, to == Piece::WHITE ? 1 : 0);
+                emitChange(BoardChange::Kind::Place, x, y, to);
+            }
         }
     }
+    endBatch();
+
+    // 未开局时保持 Idle；否则按目标局面是否已分胜负决定能否继续落子
+    if (status != Status::Idle)
+    {
+        const Step *last = ply ? &history[ply - 1] : nullptr;
+        status = (last && checkWin(last->x, last->y, last->p)) ? Status::Settled : Status::Active;
+    }
+    lastMoveAt = std::chrono::steady_clock::now();
+    emitUpdate();
     return true;
 }
+
+void Game::truncateHistory(int ply)
+{
+    if (ply >= moveCount())
+        return;
+    history.resize(ply);
+    snapshots.resize(ply / SNAPSHOT_INTERVAL);
+}
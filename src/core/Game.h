@@ -1,4 +1,9 @@
 #pragma once
+#include "GameConfig.h"
+#include "WinDetector.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <functional>
@@ -10,6 +15,72 @@ enum class Piece
     WHITE
 };
 
+/**
+ * @brief 棋盘只读视图
+ *
+ * 指向按行连续存放的 size × size 字节数组（第 x 行第 y 列在 x * size + y，每格存一个 Piece 值），
+ * 不拥有数据，随底层棋盘变化；跨线程或需要保留时复制为 BoardSnapshot。
+ */
+class BoardView
+{
+public:
+    BoardView() = default;
+    BoardView(const uint8_t *cells, int size) : cells(cells), n(size) {}
+
+    int size() const { return n; }
+    Piece at(int x, int y) const { return static_cast<Piece>(cells[x * n + y]); }
+    const uint8_t *data() const { return cells; }
+
+    // 兼容旧接口：复制为二维数组
+    std::vector<std::vector<Piece>> toRows() const;
+
+private:
+    const uint8_t *cells = nullptr;
+    int n = 0;
+};
+
+/**
+ * @brief 棋盘快照：固定容量（最大 19 × 19）的扁平副本，不做堆分配，可按值跨线程传递
+ */
+class BoardSnapshot
+{
+public:
+    static constexpr int MAX_CELLS = GameConfig::MAX_BOARD_SIZE * GameConfig::MAX_BOARD_SIZE;
+
+    BoardSnapshot() = default;
+    explicit BoardSnapshot(const BoardView &view);
+    // 兼容旧接口：从二维数组构造（超出最大尺寸的部分被截掉）
+    static BoardSnapshot fromRows(const std::vector<std::vector<Piece>> &rows);
+
+    BoardView view() const { return BoardView(cells.data(), n); }
+
+private:
+    std::array<uint8_t, MAX_CELLS> cells{};
+    int n = 0;
+};
+
+/**
+ * @brief 棋盘变化事件：只描述变化的部分
+ *
+ * Place / Remove 为落下或提走一颗子；Reset 为清空棋盘（坐标无意义）。
+ * moveIndex 与 toMove 为变化之后的手数（history 长度）与走子方。
+ */
+struct BoardChange
+{
+    enum class Kind : uint8_t
+    {
+        Place,
+        Remove,
+        Reset
+    };
+
+    Kind kind = Kind::Place;
+    int x = -1, y = -1;
+    Piece piece = Piece::EMPTY;
+    int moveIndex = 0;
+    Piece toMove = Piece::BLACK;
+};
+
 class Game
 {
 public:
@@ -25,10 +96,12 @@ public:
 
     // ==================== 配置与控制 ====================
     void setLocalMode(bool local) { isLocal = local; }
+    void setWinRule(WinDetector::Rule rule) { winRule = rule; }
     void reset();
     void start()
     {
         status = Status::Active;
+        lastMoveAt = std::chrono::steady_clock::now();
         if (onGameStarted)
             onGameStarted();
     }
@@ -50,12 +123,33 @@ public:
     bool move(int x, int y); // 玩家尝试落子
     bool undo();
     bool sync(const std::string &data);
+    bool syncRecord(const uint8_t *data, size_t length); // 二进制记录版本的 sync
     bool applyRemoteMove(int x, int y, Piece p); // 响应服务器确认
 
-    std::vector<std::vector<Piece>> getBoard() const { return board; };
+    // 零拷贝的只读视图，随对局变化；界面绘制与 AI 取棋盘都应使用它
+    BoardView getBoardView() const { return BoardView(board.data(), size); }
+    Piece at(int x, int y) const { return static_cast<Piece>(board[x * size + y]); }
+    // 兼容旧接口：按值返回二维数组（每次调用都会分配）
+    std::vector<std::vector<Piece>> getBoard() const { return getBoardView().toRows(); }
+    Piece getCurrentPlayer() const { return currPlayer; }
+
+    // ==================== 复盘 ====================
+    int moveCount() const { return static_cast<int>(history.size()); }
+    // 棋盘当前显示的手数；不在复盘时等于 moveCount()
+    int currentPly() const { return cursor; }
+    // 第 ply 手之后的棋盘（0 为空盘），不改变对局：从最近的快照补走至多 SNAPSHOT_INTERVAL - 1 手
+    BoardSnapshot boardAt(int ply) const;
+    // 把棋盘切换到第 ply 手之后（可前可后），history 保持不变；代价与 boardAt 相同，
+    // 变化合并为一次批量增量事件和一次整盘通知。之后落子或悔棋会先丢弃 ply 之后的着法
+    bool seek(int ply);
 
     // ==================== 导出接口 (回调注入) ====================
-    void setOnBoardChanged(std::function<void(const std::vector<std::vector<Piece>> &)> cb) { onBoardChanged = cb; }
+    void setOnBoardChanged(std::function<void(const BoardView &)> cb) { onBoardChanged = cb; }
+    // 增量通知：落子、悔棋、重置各触发一次，只带变化的棋子
+    void setOnBoardChange(std::function<void(const BoardChange &)> cb) { onBoardChange = cb; }
+    // 批量增量通知：sync / deserialize 重放（以 Reset 开头）与 seek 的全部变化合并为一次回调；
+    // 未设置时逐个交给 setOnBoardChange 的回调
+    void setOnBoardChangeBatch(std::function<void(const std::vector<BoardChange> &)> cb) { onBoardChangeBatch = cb; }
     void setOnTurnChanged(std::function<void(Piece)> cb) { onTurnChanged = cb; }
     void setOnGameStarted(std::function<void()> cb) { onGameStarted = cb; }
     void setOnGameEnded(std::function<void(const std::string &)> cb) { onGameEnded = cb; }
@@ -63,15 +157,26 @@ public:
     void setOnGameSyncReq(std::function<void(const std::string &)> cb) { onGameSyncReq = cb; }
 
     // ==================== 状态序列化 ====================
+    // 文本格式（兼容旧版本）；deserialize 与 deserializeRecord 一样整体校验后静默重放
     std::string serialize() const;
     bool deserialize(const std::string &data);
+    // 二进制记录（格式见 GameRecord.h）：encodeRecord 写入调用方的缓冲区，不做堆分配，
+    // 所需容量为 GameRecord::maxSize(边长, 手数, withClock)，不足时返回 0
+    size_t encodeRecord(uint8_t *buffer, size_t capacity, bool withClock = false) const;
+    std::vector<uint8_t> serializeRecord(bool withClock = false) const;
+    // 先完整校验，失败时不改变当前对局；成功时静默重放，只发一次批量增量事件和一次整盘通知
+    bool deserializeRecord(const uint8_t *data, size_t length);
 
 private:
     bool checkWin(int x, int y, Piece p) const;
+    void settleIfWon();
+    void emitChange(BoardChange::Kind kind, int x, int y, Piece p);
+    void beginBatch() { batching = true; }
+    void endBatch();
     void emitUpdate()
     {
         if (onBoardChanged)
-            onBoardChanged(board);
+            onBoardChanged(getBoardView());
         if (onTurnChanged)
             onTurnChanged(currPlayer);
     }
@@ -80,17 +185,39 @@ private:
     bool isLocal = true;
     int size = 15;
     Piece currPlayer = Piece::BLACK;
-    std::vector<std::vector<Piece>> board;
+    using Cells = std::array<uint8_t, BoardSnapshot::MAX_CELLS>;
+    Cells board{}; // 按行连续存放，第 x 行第 y 列在 x * size + y
+    WinDetector::LineMasks lines; // 与 board 同步的四方向线位串，用于胜负判定
+    WinDetector::Rule winRule = WinDetector::Rule::Freestyle;
 
     struct Step
     {
         int x, y;
         Piece p;
+        uint32_t clockMs; // 本手用时（距上一手或开局）
     };
     std::vector<Step> history; // 替代 stack，更易于遍历序列化
 
+    // 每 SNAPSHOT_INTERVAL 手保存一份棋盘，snapshots[i] 为第 (i + 1) * SNAPSHOT_INTERVAL 手之后的局面
+    static constexpr int SNAPSHOT_INTERVAL = 16;
+    std::vector<Cells> snapshots;
+    int cursor = 0; // 棋盘对应的手数（seek 的位置），其余操作后都等于 history.size()
+
+    Cells cellsAt(int ply) const;   // 第 ply 手之后的棋盘，ply 须在 [0, moveCount()] 内
+    void truncateHistory(int ply); // 丢弃第 ply 手之后的着法与快照
+
+    // 静默重放：以 steps（黑先交替）替换当前对局。先在临时棋盘上校验，有越界或重复落子时返回 false 且不改变对局；
+    // 期间不经 move()，不逐子回调、不逐子判胜，结束时发一次批量增量事件和一次整盘通知
+    bool replay(int boardSize, const std::vector<Step> &steps);
+    std::chrono::steady_clock::time_point lastMoveAt;
+
+    bool batching = false;              // 重放期间暂存增量事件
+    std::vector<BoardChange> pending;   // 暂存的增量事件
+
     // 回调句柄
-    std::function<void(const std::vector<std::vector<Piece>> &)> onBoardChanged;
+    std::function<void(const BoardView &)> onBoardChanged;
+    std::function<void(const BoardChange &)> onBoardChange;
+    std::function<void(const std::vector<BoardChange> &)> onBoardChangeBatch;
     std::function<void(Piece)> onTurnChanged;
     std::function<void()> onGameStarted;
     std::function<void(const std::string &)> onGameEnded;
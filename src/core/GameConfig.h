@@ -18,13 +18,25 @@ namespace GameConfig
     // 时间配置
     constexpr int DEFAULT_GAME_TIME_MINUTES = 20;
     constexpr int DEFAULT_INCREMENT_SECONDS = 5;
-    const char *DEFAULT_TIME_FORMAT = "mm:ss";
+    constexpr const char *DEFAULT_TIME_FORMAT = "mm:ss";
 
     // 游戏规则
     constexpr int WIN_COUNT = 5; // 五子连珠获胜
 
+    // AI配置
+    constexpr int DEFAULT_AI_HASH_MB = 16;       // 置换表大小（MB）
+    constexpr int DEFAULT_AI_MAX_DEPTH = 12;     // 迭代加深的最大深度
+    constexpr int DEFAULT_AI_MAX_MOVE_MS = 5000; // 单步思考时间上限（毫秒）
+    constexpr int DEFAULT_AI_THREADS = 1;        // 搜索线程数，0 表示使用全部核心
+    constexpr int DEFAULT_AI_MCTS_PLAYOUTS = 20000; // MCTS 每步模拟次数
+    constexpr int DEFAULT_AI_MCTS_NODES = 1 << 18;  // MCTS 节点池容量
+    constexpr const char *DEFAULT_AI_BOOK_PATH = "book/opening.bin"; // 开局库文件
+    constexpr int DEFAULT_AI_BOOK_PLIES = 10;       // 前多少手查询开局库
+    constexpr int DEFAULT_AI_PN_MB = 16;            // 证明数搜索节点表大小（MB）
+    constexpr int DEFAULT_AI_PN_NODES = 50000;      // 证明数搜索每次的节点预算
+
     // 网络配置
-    const char *DEFAULT_SERVER_IP = "169.254.56.77";
+    constexpr const char *DEFAULT_SERVER_IP = "169.254.56.77";
     constexpr int DEFAULT_SERVER_PORT = 8080;
 
     // UI配置
@@ -36,8 +48,8 @@ namespace GameConfig
 
     // 玩家配置
     constexpr int DEFAULT_PLAYER_RATING = 1500;
-    const char *DEFAULT_PLAYER_NAME = "玩家";
-    const char *AI_PLAYER_NAME_PREFIX = "AI玩家";
+    constexpr const char *DEFAULT_PLAYER_NAME = "玩家";
+    constexpr const char *AI_PLAYER_NAME_PREFIX = "AI玩家";
 
     // 游戏状态
     enum class GameMode
@@ -0,0 +1,185 @@
+#include "GameRecord.h"
+#include "GameConfig.h"
+#include <array>
+
+namespace
+{
+    constexpr uint8_t MAGIC[2] = {'G', 'R'};
+
+    std::array<uint32_t, 256> makeCrcTable()
+    {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        return table;
+    }
+
+    void putU16(uint8_t *p, uint32_t v)
+    {
+        p[0] = static_cast<uint8_t>(v);
+        p[1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    void putU32(uint8_t *p, uint32_t v)
+    {
+        putU16(p, v & 0xFFFF);
+        putU16(p + 2, v >> 16);
+    }
+
+    uint32_t getU16(const uint8_t *p) { return p[0] | (uint32_t(p[1]) << 8); }
+
+    uint32_t getU32(const uint8_t *p)
+    {
+        return p[0] | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    }
+
+    bool validSize(int n) { return n >= GameConfig::MIN_BOARD_SIZE && n <= GameConfig::MAX_BOARD_SIZE; }
+}
+
+namespace GameRecord
+{
+    size_t maxSize(int boardSize, int moveCount, bool withClock)
+    {
+        size_t perMove = cellBytes(boardSize) + (withClock ? MAX_VARINT_SIZE : 0);
+        return HEADER_SIZE + size_t(moveCount) * perMove + CRC_SIZE;
+    }
+
+    bool isRecord(const uint8_t *data, size_t size)
+    {
+        return size >= 2 && data[0] == MAGIC[0] && data[1] == MAGIC[1];
+    }
+
+    uint32_t crc32(const uint8_t *data, size_t size)
+    {
+        static const std::array<uint32_t, 256> table = makeCrcTable();
+        uint32_t c = 0xFFFFFFFFu;
+        for (size_t i = 0; i < size; ++i)
+            c = table[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+        return c ^ 0xFFFFFFFFu;
+    }
+
+    Encoder::Encoder(uint8_t *buffer, size_t capacity, int boardSize, int moveCount, bool withClock)
+        : out(buffer), capacity(capacity), n(boardSize), total(moveCount)
+    {
+        size_t movesEnd = HEADER_SIZE + size_t(moveCount) * cellBytes(boardSize);
+        clockPos = withClock ? movesEnd : 0;
+        if (!validSize(boardSize) || moveCount < 0 || moveCount > MAX_MOVES || movesEnd + CRC_SIZE > capacity)
+        {
+            failed = true;
+            return;
+        }
+        out[0] = MAGIC[0];
+        out[1] = MAGIC[1];
+        out[2] = VERSION;
+        out[3] = withClock ? FLAG_CLOCK : 0;
+        out[4] = static_cast<uint8_t>(boardSize);
+        putU16(out + 5, static_cast<uint32_t>(moveCount));
+    }
+
+    bool Encoder::add(int x, int y, uint32_t clockMs)
+    {
+        if (failed || written >= total || x < 0 || x >= n || y < 0 || y >= n)
+        {
+            failed = true;
+            return false;
+        }
+
+        uint32_t cell = static_cast<uint32_t>(x * n + y);
+        if (cellBytes(n) == 1)
+            out[HEADER_SIZE + written] = static_cast<uint8_t>(cell);
+        else
+            putU16(out + HEADER_SIZE + size_t(written) * 2, cell);
+
+        if (clockPos)
+        {
+            // LEB128：每字节低 7 位为数据，最高位表示后面还有
+            do
+            {
+                if (clockPos + CRC_SIZE >= capacity)
+                {
+                    failed = true;
+                    return false;
+                }
+                uint8_t byte = clockMs & 0x7F;
+                clockMs >>= 7;
+                out[clockPos++] = clockMs ? (byte | 0x80) : byte;
+            } while (clockMs);
+        }
+        ++written;
+        return true;
+    }
+
+    size_t Encoder::finish()
+    {
+        if (failed || written != total)
+            return 0;
+        size_t length = clockPos ? clockPos : HEADER_SIZE + size_t(total) * cellBytes(n);
+        putU32(out + length, crc32(out, length));
+        return length + CRC_SIZE;
+    }
+
+    Decoder::Decoder(const uint8_t *data, size_t size) : in(data)
+    {
+        if (size < HEADER_SIZE + CRC_SIZE || !isRecord(data, size) || data[2] != VERSION || (data[3] & ~FLAG_CLOCK))
+            return;
+        n = data[4];
+        total = static_cast<int>(getU16(data + 5));
+        end = size - CRC_SIZE;
+        size_t movesEnd = HEADER_SIZE + size_t(total) * cellBytes(n);
+        if (!validSize(n) || movesEnd > end || getU32(data + end) != crc32(data, end))
+            return;
+        // 不带用时列（或没有着法）时着法列必须恰好填满；用时列的长度在读完最后一手时检查
+        bool withClock = data[3] & FLAG_CLOCK;
+        if ((!withClock || total == 0) && movesEnd != end)
+            return;
+        clockPos = withClock ? movesEnd : 0;
+        ok = true;
+    }
+
+    bool Decoder::next(int &x, int &y, uint32_t &clockMs)
+    {
+        if (!ok || decoded >= total)
+            return false;
+
+        uint32_t cell = cellBytes(n) == 1 ? in[HEADER_SIZE + decoded] : getU16(in + HEADER_SIZE + size_t(decoded) * 2);
+        if (cell >= uint32_t(n * n))
+        {
+            ok = false;
+            return false;
+        }
+
+        clockMs = 0;
+        if (clockPos)
+        {
+            for (int shift = 0;; shift += 7)
+            {
+                if (clockPos >= end || shift >= 35)
+                {
+                    ok = false;
+                    return false;
+                }
+                uint8_t byte = in[clockPos++];
+                clockMs |= uint32_t(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    break;
+            }
+        }
+
+        // 用时列必须恰好在 CRC 前结束，不接受尾随字节
+        if (clockPos && decoded + 1 == total && clockPos != end)
+        {
+            ok = false;
+            return false;
+        }
+
+        x = static_cast<int>(cell) / n;
+        y = static_cast<int>(cell) % n;
+        ++decoded;
+        return true;
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 二进制对局记录（Game::serialize 文本格式的紧凑替代）
+ *
+ * 布局（多字节整数均为小端）：
+ *   [0..1] 魔数 'G' 'R'
+ *   [2]    版本号
+ *   [3]    标志位，bit0 表示带用时列
+ *   [4]    棋盘边长
+ *   [5..6] 手数 N
+ *   着法列 N 项格子下标 x * size + y；格子数不超过 256 时每项 1 字节，否则 2 字节
+ *   用时列 （可选）N 个 LEB128 变长整数，每手用时（毫秒）
+ *   [末 4] CRC-32，覆盖之前的全部字节
+ * 颜色不存：黑先，双方交替。15 路棋盘每手 1 字节，比文本格式小 5 倍以上。
+ *
+ * 编码器与解码器只读写调用方给出的缓冲区，不做堆分配。
+ */
+namespace GameRecord
+{
+    constexpr uint8_t VERSION = 1;
+    constexpr uint8_t FLAG_CLOCK = 0x01;
+    constexpr size_t HEADER_SIZE = 7;
+    constexpr size_t CRC_SIZE = 4;
+    constexpr size_t MAX_VARINT_SIZE = 5; // uint32 的 LEB128 编码最长 5 字节
+    constexpr int MAX_MOVES = 0xFFFF;
+
+    // 每手着法占用的字节数
+    constexpr int cellBytes(int boardSize) { return boardSize * boardSize <= 256 ? 1 : 2; }
+
+    // 容纳 moveCount 手所需的最大字节数（用时列按最长编码计）
+    size_t maxSize(int boardSize, int moveCount, bool withClock);
+
+    // 是否以二进制记录的魔数开头（文本格式以 "v:" 开头，两者不会混淆）
+    bool isRecord(const uint8_t *data, size_t size);
+
+    // 标准 CRC-32（多项式 0xEDB88320）
+    uint32_t crc32(const uint8_t *data, size_t size);
+
+    /**
+     * @brief 编码器：手数须预先给出，着法列定长、用时列紧随其后，因此可以边遍历边写
+     */
+    class Encoder
+    {
+    public:
+        Encoder(uint8_t *buffer, size_t capacity, int boardSize, int moveCount, bool withClock);
+
+        // 依次写入一手；坐标越界、超出预定手数或缓冲区不足时返回 false，之后 finish() 返回 0
+        bool add(int x, int y, uint32_t clockMs = 0);
+        // 写入 CRC 并返回记录总长度；出错或手数不足时返回 0
+        size_t finish();
+
+    private:
+        uint8_t *out;
+        size_t capacity;
+        int n;
+        int total;
+        int written = 0;
+        size_t clockPos; // 下一个用时的写入位置，不带用时列时为 0
+        bool failed = false;
+    };
+
+    /**
+     * @brief 解码器：构造时校验头部、长度与 CRC，之后用 next() 依次取出各手
+     */
+    class Decoder
+    {
+    public:
+        Decoder(const uint8_t *data, size_t size);
+
+        bool valid() const { return ok; }
+        int boardSize() const { return n; }
+        int moveCount() const { return total; }
+        bool hasClock() const { return clockPos != 0; }
+
+        // 取出下一手（不带用时列时 clockMs 为 0）；已读完或数据损坏时返回 false
+        bool next(int &x, int &y, uint32_t &clockMs);
+
+    private:
+        const uint8_t *in = nullptr;
+        size_t end = 0; // CRC 之前的长度
+        int n = 0;
+        int total = 0;
+        int decoded = 0;
+        size_t clockPos = 0;
+        bool ok = false;
+    };
+}
+
+#endif // GAMERECORD_H
@@ -0,0 +1,47 @@
+#include "Heuristics.h"
+#include "EvalWeights.h"
+#include "PatternTable.h"
+
+namespace Heuristics
+{
+    int evaluatePosition(const Bitboard &board, int x, int y, Piece player)
+    {
+        if (!board.inBoard(x, y) || !board.isEmpty(x, y))
+            return 0;
+
+        static const PatternTable &table = PatternTable::instance();
+        int score = 0;
+
+        // 检查四个方向（垂直、水平、主对角线、副对角线）
+        for (int dir = 0; dir < BoardBits::DIRS; dir++)
+        {
+            uint32_t own, block;
+            board.window(x, y, dir, player, own, block);
+            score += table.score(table.encode(own, block));
+        }
+
+        return score;
+    }
+
+    int getMoveHeuristicScore(const Bitboard &board, int x, int y, Piece aiColor, Piece humanColor)
+    {
+        int aiScore = evaluatePosition(board, x, y, aiColor);
+        int humanScore = evaluatePosition(board, x, y, humanColor);
+        return aiScore + humanScore * EvalWeights::DEFENSE_WEIGHT; // 防守更重要
+    }
+
+    bool makesFive(const Bitboard &board, int x, int y, Piece player)
+    {
+        const BoardGeometry &geo = board.geometry();
+        int idx = BoardBits::index(x, y);
+        int c = BoardBits::colorIndex(player);
+        bool five = false;
+        for (int d = 0; d < BoardBits::DIRS; ++d)
+        {
+            // 假设 (x, y) 已落子
+            int b = geo.pos[d][idx] + BoardBits::LINE_PAD;
+            five |= WinDetector::fiveThrough(board.lineWord(c, d, geo.line[d][idx]) | (1u << b), b);
+        }
+        return five;
+    }
+}
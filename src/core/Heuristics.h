@@ -0,0 +1,23 @@
+#ifndef HEURISTICS_H
+#define HEURISTICS_H
+
+#include "Bitboard.h"
+
+/**
+ * @brief 落子启发式
+ *
+ * 基于棋形表的单点打分，供 Alpha-Beta 的着法排序与 MCTS 的先验/走子策略共用。
+ */
+namespace Heuristics
+{
+    // 计算单个位置的得分：四个方向各取 7 格窗口（中心按空位计），编码后查棋形表（非空位为 0）
+    int evaluatePosition(const Bitboard &board, int x, int y, Piece player);
+
+    // 获取移动的启发式得分（用于排序）：进攻分 + 2 × 防守分
+    int getMoveHeuristicScore(const Bitboard &board, int x, int y, Piece aiColor, Piece humanColor);
+
+    // player 在空位 (x, y) 落子后是否成五（不改动棋盘）
+    bool makesFive(const Bitboard &board, int x, int y, Piece player);
+}
+
+#endif // HEURISTICS_H
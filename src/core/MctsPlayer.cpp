@@ -0,0 +1,342 @@
+#include "MctsPlayer.h"
+#include "Heuristics.h"
+#include "PatternBatch.h"
+#include "Timer.hpp"
+#include <algorithm>
+#include <cmath>
+
+using namespace BoardBits;
+
+namespace
+{
+    constexpr int MAX_CHILDREN = 15;    // 每个节点展开的候选着法数
+    constexpr int ROLLOUT_PLIES = 40;   // 模拟步数上限，超过按和棋计
+    constexpr float C_PUCT = 1.5f;      // 探索系数
+    constexpr float FIRST_PLAY = 0.5f;  // 未访问子节点的估值
+    constexpr int TIME_CHECK_MASK = 63; // 每 64 次模拟检查一次时间
+}
+
+MctsPlayer::MctsPlayer(Piece color)
+    : aiColor(color), boardSize(GameConfig::DEFAULT_BOARD_SIZE), rootBoard(boardSize), rng(0x5A0B21C4u)
+{
+    limits.nodes = GameConfig::DEFAULT_AI_MCTS_PLAYOUTS;
+    setArenaSize(GameConfig::DEFAULT_AI_MCTS_NODES);
+}
+
+void MctsPlayer::setBoardSize(int size)
+{
+    boardSize = size;
+    resetTree();
+}
+
+void MctsPlayer::setSearchLimits(const SearchLimits &searchLimits)
+{
+    limits = searchLimits;
+    if (limits.nodes == 0)
+        limits.nodes = GameConfig::DEFAULT_AI_MCTS_PLAYOUTS;
+}
+
+void MctsPlayer::setArenaSize(size_t nodes)
+{
+    nodes = std::max<size_t>(nodes, MAX_CHILDREN + 1);
+    pool.assign(nodes, Node());
+    spare.assign(nodes, Node());
+    resetTree();
+}
+
+Piece MctsPlayer::getColor() const
+{
+    return aiColor;
+}
+
+void MctsPlayer::abortSearch()
+{
+    abortRequested = true;
+}
+
+void MctsPlayer::clearAbort()
+{
+    abortRequested = false;
+}
+
+void MctsPlayer::resetTree()
+{
+    pool[0] = Node();
+    used = 1;
+    hasTree = false;
+}
+
+bool MctsPlayer::reuseTree(const Bitboard &board)
+{
+    if (!hasTree || board.size() != rootBoard.size())
+        return false;
+
+    Piece humanColor = opponent(aiColor);
+    // 上次的根局面必须是当前局面的子集，且双方各多一子
+    for (Piece p : {aiColor, humanColor})
+    {
+        if (rootBoard.stones(p).andNot(board.stones(p)).any())
+            return false;
+    }
+    BitPlane ownNew = board.stones(aiColor).andNot(rootBoard.stones(aiColor));
+    BitPlane oppNew = board.stones(humanColor).andNot(rootBoard.stones(humanColor));
+    if (ownNew.count() != 1 || oppNew.count() != 1)
+        return false;
+
+    int ownIdx = -1, oppIdx = -1;
+    ownNew.forEach([&](int idx)
+                   { ownIdx = idx; });
+    oppNew.forEach([&](int idx)
+                   { oppIdx = idx; });
+
+    auto findChild = [this](int32_t node, int move) -> int32_t
+    {
+        const Node &n = pool[node];
+        for (int i = 0; i < n.childCount; ++i)
+        {
+            if (pool[n.firstChild + i].move == move)
+                return n.firstChild + i;
+        }
+        return -1;
+    };
+
+    int32_t child = findChild(0, ownIdx);
+    if (child < 0)
+        return false;
+    int32_t grandChild = findChild(child, oppIdx);
+    if (grandChild < 0)
+        return false;
+
+    reroot(grandChild);
+    return true;
+}
+
+void MctsPlayer::reroot(int32_t node)
+{
+    // 按层序把子树搬到备用池，同一节点的子节点仍连续存放，然后交换两个池
+    spare[0] = pool[node];
+    size_t top = 1;
+    for (size_t i = 0; i < top; ++i)
+    {
+        Node &n = spare[i];
+        if (n.childCount == 0)
+            continue;
+        int32_t old = n.firstChild;
+        n.firstChild = static_cast<int32_t>(top);
+        for (int c = 0; c < n.childCount; ++c)
+            spare[top++] = pool[old + c];
+    }
+    std::swap(pool, spare);
+    used = top;
+}
+
+std::pair<int, int> MctsPlayer::getNextMove(const BoardView &board)
+{
+    Bitboard bb = Bitboard::fromBoard(board, boardSize);
+    playouts = 0;
+
+    // 空棋盘直接下天元
+    if (bb.stoneCount() == 0)
+    {
+        resetTree();
+        return {bb.size() / 2, bb.size() / 2};
+    }
+
+    if (!reuseTree(bb))
+        resetTree();
+    rootBoard = bb;
+    hasTree = true;
+
+    if (!pool[0].expanded && !expand(0, rootBoard, aiColor))
+        return {-1, -1};
+
+    uint64_t start = GetTimeMS();
+    uint64_t timeLimit = limits.timeMs > 0 ? limits.timeMs : GameConfig::DEFAULT_AI_MAX_MOVE_MS;
+    while (playouts < limits.nodes && !abortRequested.load(std::memory_order_relaxed))
+    {
+        playout();
+        ++playouts;
+        if ((playouts & TIME_CHECK_MASK) == 0 && GetTimeMS() - start >= timeLimit)
+            break;
+    }
+
+    // 选访问次数最多的根着法
+    const Node &root = pool[0];
+    int32_t best = -1;
+    for (int i = 0; i < root.childCount; ++i)
+    {
+        int32_t c = root.firstChild + i;
+        if (best < 0 || pool[c].visits > pool[best].visits)
+            best = c;
+    }
+    if (best < 0)
+        return {-1, -1};
+    return {toX(pool[best].move), toY(pool[best].move)};
+}
+
+void MctsPlayer::playout()
+{
+    Bitboard bb = rootBoard;
+    Piece toMove = aiColor;
+    int32_t path[BoardBits::CELLS + 1];
+    int length = 0;
+    path[length++] = 0;
+
+    // 选择：沿 PUCT 值最大的子节点下行，直到叶子或终局
+    int winner = -1;
+    int32_t node = 0;
+    while (true)
+    {
+        Node &n = pool[node];
+        if (n.terminal)
+        {
+            winner = colorIndex(opponent(toMove)); // 走出该着法的一方成五
+            break;
+        }
+        if (!n.expanded)
+        {
+            // 叶子第二次被访问时才展开，首次访问直接模拟
+            if (n.visits == 0 || !expand(node, bb, toMove))
+            {
+                winner = rollout(bb, toMove);
+                break;
+            }
+        }
+        if (n.childCount == 0)
+            break; // 棋盘已满，和棋
+
+        node = selectChild(node);
+        int move = pool[node].move;
+        bb.place(toX(move), toY(move), toMove);
+        toMove = opponent(toMove);
+        path[length++] = node;
+    }
+
+    // 回传：路径上每个节点从其走子方视角累计结果；根的走子方是对手
+    int mover = colorIndex(opponent(aiColor));
+    for (int i = 0; i < length; ++i)
+    {
+        Node &n = pool[path[i]];
+        ++n.visits;
+        n.wins += winner < 0 ? 0.5f : (winner == mover ? 1.0f : 0.0f);
+        mover ^= 1;
+    }
+}
+
+bool MctsPlayer::expand(int32_t node, const Bitboard &board, Piece toMove)
+{
+    Piece other = opponent(toMove);
+    std::vector<std::pair<int, int>> scored; // (得分, 位平面索引)
+    std::vector<int> wins, blocks;
+    BitPlane candidates = board.neighbours(2);
+    if (!candidates.any())
+        candidates = board.empties();
+
+    int16_t cells[CELLS];
+    int32_t scores[CELLS];
+    int cellCount = 0;
+    candidates.forEach([&](int idx)
+                       {
+        int x = toX(idx), y = toY(idx);
+        if (Heuristics::makesFive(board, x, y, toMove))
+            wins.push_back(idx);
+        else if (Heuristics::makesFive(board, x, y, other))
+            blocks.push_back(idx);
+        cells[cellCount++] = static_cast<int16_t>(idx); });
+    PatternBatch::scoreMoves(board, cells, cellCount, toMove, scores);
+    for (int i = 0; i < cellCount; ++i)
+        scored.push_back({scores[i], cells[i]});
+
+    // 能成五只展开成五点；对方能成五只展开挡点
+    if (!wins.empty() || !blocks.empty())
+    {
+        const std::vector<int> &forced = wins.empty() ? blocks : wins;
+        scored.erase(std::remove_if(scored.begin(), scored.end(), [&](const std::pair<int, int> &s)
+                                    { return std::find(forced.begin(), forced.end(), s.second) == forced.end(); }),
+                     scored.end());
+    }
+
+    size_t count = std::min<size_t>(scored.size(), MAX_CHILDREN);
+    if (used + count > pool.size())
+        return false;
+    std::partial_sort(scored.begin(), scored.begin() + count, scored.end(),
+                      [](const std::pair<int, int> &a, const std::pair<int, int> &b)
+                      { return a.first > b.first; });
+
+    // 先验取得分的平方根再归一化，避免冲四、活四之类的高分点完全压死其他着法
+    double total = 0;
+    for (size_t i = 0; i < count; ++i)
+        total += std::sqrt(std::max(scored[i].first, 1));
+
+    Node &n = pool[node];
+    n.firstChild = static_cast<int32_t>(used);
+    n.childCount = static_cast<uint16_t>(count);
+    n.expanded = true;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Node &c = pool[used++];
+        c = Node();
+        c.move = static_cast<int16_t>(scored[i].second);
+        c.prior = static_cast<float>(std::sqrt(std::max(scored[i].first, 1)) / total);
+        c.terminal = !wins.empty();
+    }
+    return true;
+}
+
+int32_t MctsPlayer::selectChild(int32_t node) const
+{
+    const Node &n = pool[node];
+    float sqrtVisits = std::sqrt(static_cast<float>(n.visits) + 1.0f);
+    int32_t best = n.firstChild;
+    float bestValue = -1.0f;
+    for (int i = 0; i < n.childCount; ++i)
+    {
+        const Node &c = pool[n.firstChild + i];
+        float q = c.visits ? c.wins / c.visits : FIRST_PLAY;
+        float value = q + C_PUCT * c.prior * sqrtVisits / (1.0f + c.visits);
+        if (value > bestValue)
+        {
+            bestValue = value;
+            best = n.firstChild + i;
+        }
+    }
+    return best;
+}
+
+int MctsPlayer::rollout(Bitboard &board, Piece toMove)
+{
+    std::uniform_real_distribution<float> noise(0.5f, 1.5f);
+    for (int ply = 0; ply < ROLLOUT_PLIES; ++ply)
+    {
+        Piece other = opponent(toMove);
+        int win = -1, block = -1, best = -1;
+        float bestValue = -1.0f;
+        board.neighbours(1).forEach([&](int idx)
+                                    {
+            if (win >= 0)
+                return;
+            int x = toX(idx), y = toY(idx);
+            if (Heuristics::makesFive(board, x, y, toMove))
+            {
+                win = idx;
+                return;
+            }
+            if (Heuristics::makesFive(board, x, y, other))
+                block = idx;
+            float value = (Heuristics::getMoveHeuristicScore(board, x, y, toMove, other) + 1) * noise(rng);
+            if (value > bestValue)
+            {
+                bestValue = value;
+                best = idx;
+            } });
+
+        if (win >= 0)
+            return colorIndex(toMove);
+        int move = block >= 0 ? block : best;
+        if (move < 0)
+            return -1; // 棋盘已满
+        board.place(toX(move), toY(move), toMove);
+        toMove = other;
+    }
+    return -1;
+}
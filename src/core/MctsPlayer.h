@@ -0,0 +1,79 @@
+#ifndef MCTSPLAYER_H
+#define MCTSPLAYER_H
+
+#include "AiEngine.h"
+#include "Bitboard.h"
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @brief 蒙特卡洛树搜索（PUCT）AI
+ *
+ * 展开时以落子启发式的得分作为子节点先验，模拟时按启发式加随机扰动走子（能成五先成五、
+ * 对方能成五先挡），直到分出胜负或达到步数上限。
+ * 节点分配在固定容量的节点池中，子节点连续存放；下一步开始时若双方着法都在树中，
+ * 就把对应子树整理到备用池作为新根，保留已有的统计。
+ */
+class MctsPlayer : public AiEngine
+{
+public:
+    explicit MctsPlayer(Piece color);
+
+    void setBoardSize(int size) override;
+    // nodes 为每步模拟次数（0 取默认值），timeMs 为单步用时上限（0 取默认值）
+    void setSearchLimits(const SearchLimits &searchLimits) override;
+    // 节点池容量（节点数），会清空搜索树
+    void setArenaSize(size_t nodes);
+
+    using AiEngine::getNextMove;
+    std::pair<int, int> getNextMove(const BoardView &board) override;
+    Piece getColor() const override;
+
+    void abortSearch() override;
+    void clearAbort() override;
+
+    uint64_t lastPlayouts() const { return playouts; }
+    size_t treeSize() const { return used; }
+
+private:
+    struct Node
+    {
+        int32_t firstChild = -1;
+        uint16_t childCount = 0;
+        int16_t move = -1;   // 位平面索引
+        uint32_t visits = 0;
+        float wins = 0;      // 从走出该着法一方的视角累计的胜分（和棋计 0.5）
+        float prior = 0;
+        bool terminal = false; // 该着法直接成五
+        bool expanded = false;
+    };
+
+    void resetTree();
+    // 若上次的根到当前局面恰好相差双方各一手且都在树中，则以该孙节点为新根
+    bool reuseTree(const Bitboard &board);
+    void reroot(int32_t node);
+
+    void playout();
+    bool expand(int32_t node, const Bitboard &board, Piece toMove);
+    int32_t selectChild(int32_t node) const;
+    // 返回胜方颜色下标，和棋返回 -1
+    int rollout(Bitboard &board, Piece toMove);
+
+    Piece aiColor;
+    int boardSize;
+    SearchLimits limits;
+
+    std::vector<Node> pool;
+    std::vector<Node> spare; // 换根时整理子树用的备用池
+    size_t used = 0;
+    Bitboard rootBoard;
+    bool hasTree = false;
+
+    std::mt19937 rng;
+    uint64_t playouts = 0;
+    std::atomic<bool> abortRequested{false};
+};
+
+#endif // MCTSPLAYER_H
@@ -0,0 +1,147 @@
+#include "MovePicker.h"
+#include "PatternBatch.h"
+#include "Threats.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace BoardBits;
+
+namespace
+{
+    // 取出并清除最低的置位，没有时返回 -1
+    int popFirst(BitPlane &plane)
+    {
+        for (uint64_t &v : plane.w)
+        {
+            if (v)
+            {
+                int idx = int(&v - plane.w.data()) * 64 + __builtin_ctzll(v);
+                v &= v - 1;
+                return idx;
+            }
+        }
+        return -1;
+    }
+}
+
+MovePicker::MovePicker(const Bitboard &board, const BitPlane &candidates, Piece side, int ttMove,
+                       const int16_t *killers, const int32_t *history, int limit)
+    : board(board), candidates(candidates), limit(limit), side(side), ttMove(ttMove), killers(killers), history(history)
+{
+}
+
+void MovePicker::generate()
+{
+    // 得分为走子方的进攻分 + 2 × 防守分，整批一次算完
+    int16_t cells[MAX_CANDIDATES];
+    int32_t scores[MAX_CANDIDATES];
+    candidates.forEach([&](int idx)
+                       { cells[count++] = static_cast<int16_t>(idx); });
+    PatternBatch::scoreMoves(board, cells, count, side, scores);
+    for (int i = 0; i < count; ++i)
+        moves[i] = {cells[i], scores[i]};
+
+    // 没有邻居时取中心附近的空位
+    if (count == 0)
+    {
+        int center = board.size() / 2;
+        board.empties().forEach([&](int idx)
+                                { moves[count++] = {static_cast<int16_t>(idx),
+                                                    -(std::abs(toX(idx) - center) + std::abs(toY(idx) - center))}; });
+    }
+
+    // 只保留前 limit 个（线性时间选出，不排序）；已给出的着法一并参与选择，保留的集合与预先打分时相同
+    if (count > limit)
+    {
+        std::nth_element(moves, moves + limit, moves + count, [](const Candidate &a, const Candidate &b)
+                         { return a.score > b.score; });
+        count = limit;
+    }
+}
+
+bool MovePicker::isCandidate(int idx) const
+{
+    // 没有邻居的局面（空盘）候选集合为空，此时不给出杀手着法
+    return idx >= 0 && candidates.test(idx) && !done.test(idx);
+}
+
+int MovePicker::next()
+{
+    switch (stage)
+    {
+    case Stage::TTMove:
+        stage = Stage::Tactical;
+        // 置换表着法即使不在候选中也要先走（只要该点仍为空）
+        if (ttMove >= 0 && board.geometry().valid.test(ttMove) && board.isEmpty(toX(ttMove), toY(ttMove)))
+        {
+            done.set(ttMove);
+            lastQuiet = false;
+            return ttMove;
+        }
+        [[fallthrough]];
+
+    case Stage::Tactical:
+        if (!tacticalReady)
+        {
+            // 先己方成五点，再对方成五点（挡五）；成五点总在候选中，按线移位求出，不必逐点判断
+            int me = colorIndex(side);
+            ownFives = Threats::fivePoints(board, me).andNot(done) & candidates;
+            oppFives = Threats::fivePoints(board, me ^ 1).andNot(done).andNot(ownFives) & candidates;
+            tacticalReady = true;
+        }
+        for (BitPlane *plane : {&ownFives, &oppFives})
+        {
+            int idx = popFirst(*plane);
+            if (idx >= 0)
+            {
+                done.set(idx);
+                lastQuiet = false;
+                return idx;
+            }
+        }
+        stage = Stage::Killers;
+        [[fallthrough]];
+
+    case Stage::Killers:
+        while (cursor < 2)
+        {
+            int killer = killers[cursor++];
+            if (isCandidate(killer))
+            {
+                done.set(killer);
+                lastQuiet = true;
+                return killer;
+            }
+        }
+        stage = Stage::Quiets;
+        generate();
+        [[fallthrough]];
+
+    case Stage::Quiets:
+    {
+        // 选出剩余中历史得分最高的（同分按启发式得分）
+        Candidate *best = nullptr;
+        for (int i = 0; i < count; ++i)
+        {
+            Candidate &c = moves[i];
+            if (done.test(c.idx))
+                continue;
+            if (!best || history[c.idx] > history[best->idx] ||
+                (history[c.idx] == history[best->idx] && c.score > best->score))
+                best = &c;
+        }
+        if (best)
+        {
+            done.set(best->idx);
+            lastQuiet = true;
+            return best->idx;
+        }
+        stage = Stage::Done;
+        [[fallthrough]];
+    }
+
+    case Stage::Done:
+    default:
+        return -1;
+    }
+}
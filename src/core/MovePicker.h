@@ -0,0 +1,70 @@
+#ifndef MOVEPICKER_H
+#define MOVEPICKER_H
+
+#include "Bitboard.h"
+#include <cstdint>
+
+/**
+ * @brief 分阶段的着法生成器
+ *
+ * 候选着法由调用方给出（通常为 Position::candidates()），按以下顺序逐个给出，不做整体排序：
+ *   1. 置换表着法（上次搜索的最佳着法）；
+ *   2. 立即成五的着法，再是挡住对方成五的着法；
+ *   3. 本层的两个杀手着法（须在候选中）；
+ *   4. 其余着法按落子启发式保留前 limit 个（与原先的贪心剪枝一致），
+ *      再按历史表得分（同分时按启发式得分）每次选出剩余中最好的一个。
+ * 启发式打分推迟到第 4 阶段才整批进行，在置换表着法、成五/挡五或杀手着法处剪枝的节点不必打分。
+ */
+class MovePicker
+{
+public:
+    static constexpr int MAX_CANDIDATES = BoardBits::CELLS;
+
+    // killers 指向本层的两个杀手着法，history 为走子方的历史表（按位平面索引）
+    MovePicker(const Bitboard &board, const BitPlane &candidates, Piece side, int ttMove,
+               const int16_t *killers, const int32_t *history, int limit);
+
+    // 下一个着法的位平面索引，没有时返回 -1
+    int next();
+
+    // 上一个着法是否为普通着法（可记入杀手与历史表）
+    bool lastIsQuiet() const { return lastQuiet; }
+
+private:
+    enum class Stage : uint8_t
+    {
+        TTMove,
+        Tactical,
+        Killers,
+        Quiets,
+        Done
+    };
+
+    struct Candidate
+    {
+        int16_t idx;
+        int score; // 落子启发式得分
+    };
+
+    void generate(); // 整批打分并只保留前 limit 个，进入第 4 阶段时调用一次
+    bool isCandidate(int idx) const; // 在候选中且尚未给出
+
+    const Bitboard &board;
+    BitPlane candidates;
+    int limit;
+    Piece side;
+    int ttMove;
+    const int16_t *killers;
+    const int32_t *history;
+
+    Stage stage = Stage::TTMove;
+    int cursor = 0; // 杀手阶段的进度
+    bool lastQuiet = false;
+    BitPlane done;  // 已给出的着法
+    bool tacticalReady = false;
+    BitPlane ownFives, oppFives; // 尚未给出的己方 / 对方成五点
+    int count = 0;
+    Candidate moves[MAX_CANDIDATES];
+};
+
+#endif // MOVEPICKER_H
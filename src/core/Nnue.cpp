@@ -0,0 +1,239 @@
+#include "Nnue.h"
+#include "CpuFeatures.h"
+#include "SearchTypes.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef GOMOKU_X86
+#include <immintrin.h>
+#endif
+
+using namespace BoardBits;
+
+namespace
+{
+    constexpr char MAGIC[8] = {'G', 'M', 'K', 'N', 'N', 'U', 'E', '1'};
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t hidden;
+        uint32_t l1;
+        int32_t outputScale;
+    };
+
+    static_assert(sizeof(Header) == 24, "network header layout");
+
+    template <typename T>
+    bool readArray(std::istream &in, std::vector<T> &values, size_t count)
+    {
+        values.resize(count);
+        return static_cast<bool>(in.read(reinterpret_cast<char *>(values.data()), count * sizeof(T)));
+    }
+
+    constexpr int INPUTS = 2 * NnueNetwork::HIDDEN;
+
+    // 两个视角拼接后截断到 [0, ACTIVATION_MAX]
+    void activateScalar(const int16_t *own, const int16_t *other, uint8_t *input)
+    {
+        for (int i = 0; i < NnueNetwork::HIDDEN; ++i)
+        {
+            input[i] = static_cast<uint8_t>(std::clamp<int>(own[i], 0, NnueNetwork::ACTIVATION_MAX));
+            input[NnueNetwork::HIDDEN + i] =
+                static_cast<uint8_t>(std::clamp<int>(other[i], 0, NnueNetwork::ACTIVATION_MAX));
+        }
+    }
+
+    void affineScalar(const uint8_t *input, const int8_t *weights, int32_t *sums)
+    {
+        for (int o = 0; o < NnueNetwork::L1_SIZE; ++o)
+        {
+            const int8_t *row = weights + o * INPUTS;
+            int32_t sum = 0;
+            for (int i = 0; i < INPUTS; ++i)
+                sum += int32_t(input[i]) * row[i];
+            sums[o] = sum;
+        }
+    }
+
+    void addRowScalar(int16_t *acc, const int16_t *row)
+    {
+        for (int i = 0; i < NnueNetwork::HIDDEN; ++i)
+            acc[i] = static_cast<int16_t>(acc[i] + row[i]);
+    }
+
+    void subRowScalar(int16_t *acc, const int16_t *row)
+    {
+        for (int i = 0; i < NnueNetwork::HIDDEN; ++i)
+            acc[i] = static_cast<int16_t>(acc[i] - row[i]);
+    }
+
+#ifdef GOMOKU_X86
+    GOMOKU_TARGET_AVX2 void activateAvx2(const int16_t *own, const int16_t *other, uint8_t *input)
+    {
+        const __m256i limit = _mm256_set1_epi8(NnueNetwork::ACTIVATION_MAX);
+        const int16_t *halves[2] = {own, other};
+        for (int h = 0; h < 2; ++h)
+        {
+            for (int i = 0; i < NnueNetwork::HIDDEN; i += 32)
+            {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(halves[h] + i));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(halves[h] + i + 16));
+                // packus 截断到 [0, 255] 且按 128 位分道交错，重排后再取上限
+                __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(input + h * NnueNetwork::HIDDEN + i),
+                                    _mm256_min_epu8(packed, limit));
+            }
+        }
+    }
+
+    GOMOKU_TARGET_AVX2 void affineAvx2(const uint8_t *input, const int8_t *weights, int32_t *sums)
+    {
+        // 输入不超过 127，|权重| 不超过 128，maddubs 的相邻两项之和不会饱和；
+        // 每次算 4 个输出，共用输入的加载，最后用水平加法一起归约
+        const __m256i ones = _mm256_set1_epi16(1);
+        for (int o = 0; o < NnueNetwork::L1_SIZE; o += 4)
+        {
+            const int8_t *row = weights + o * INPUTS;
+            __m256i acc[4] = {_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(),
+                              _mm256_setzero_si256()};
+            for (int i = 0; i < INPUTS; i += 32)
+            {
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i));
+                for (int k = 0; k < 4; ++k)
+                {
+                    __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + k * INPUTS + i));
+                    acc[k] = _mm256_add_epi32(acc[k], _mm256_madd_epi16(_mm256_maddubs_epi16(x, w), ones));
+                }
+            }
+            __m256i pair = _mm256_hadd_epi32(_mm256_hadd_epi32(acc[0], acc[1]), _mm256_hadd_epi32(acc[2], acc[3]));
+            __m128i total = _mm_add_epi32(_mm256_castsi256_si128(pair), _mm256_extracti128_si256(pair, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(sums + o), total);
+        }
+    }
+
+    GOMOKU_TARGET_AVX2 void addRowAvx2(int16_t *acc, const int16_t *row)
+    {
+        for (int i = 0; i < NnueNetwork::HIDDEN; i += 16)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + i));
+            __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + i), _mm256_add_epi16(a, w));
+        }
+    }
+
+    GOMOKU_TARGET_AVX2 void subRowAvx2(int16_t *acc, const int16_t *row)
+    {
+        for (int i = 0; i < NnueNetwork::HIDDEN; i += 16)
+        {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + i));
+            __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc + i), _mm256_sub_epi16(a, w));
+        }
+    }
+#endif
+}
+
+bool NnueNetwork::load(const std::string &path)
+{
+    loaded = false;
+    std::ifstream in(path, std::ios::binary);
+    Header header;
+    if (!in || !in.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        return false;
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.hidden != HIDDEN || header.l1 != L1_SIZE || header.outputScale <= 0)
+        return false;
+
+    outputScale = header.outputScale;
+    if (!readArray(in, featureBias, HIDDEN) || !readArray(in, featureWeights, size_t(FEATURES) * HIDDEN) ||
+        !readArray(in, l1Bias, L1_SIZE) || !readArray(in, l1Weights, size_t(L1_SIZE) * INPUTS) ||
+        !in.read(reinterpret_cast<char *>(&outputBias), sizeof(outputBias)) ||
+        !readArray(in, outputWeights, L1_SIZE))
+        return false;
+
+    vectorized = CpuFeatures::hasAvx2();
+    loaded = true;
+    return true;
+}
+
+bool NnueNetwork::setVectorized(bool enabled)
+{
+    if (enabled && !CpuFeatures::hasAvx2())
+        return false;
+    vectorized = enabled;
+    return true;
+}
+
+int NnueNetwork::feature(int perspective, int x, int y, Piece p)
+{
+    int square = x * MAX_SIZE + y;
+    return colorIndex(p) == perspective ? square : SQUARES + square;
+}
+
+void NnueNetwork::refresh(NnueAccumulator &acc, const Bitboard &board) const
+{
+    for (int c = 0; c < 2; ++c)
+        std::copy(featureBias.begin(), featureBias.end(), acc.values[c]);
+    for (Piece p : {Piece::BLACK, Piece::WHITE})
+        board.stones(p).forEach([&](int idx)
+                                { addStone(acc, toX(idx), toY(idx), p); });
+}
+
+void NnueNetwork::addStone(NnueAccumulator &acc, int x, int y, Piece p) const
+{
+    update(acc, x, y, p, true);
+}
+
+void NnueNetwork::removeStone(NnueAccumulator &acc, int x, int y, Piece p) const
+{
+    update(acc, x, y, p, false);
+}
+
+void NnueNetwork::update(NnueAccumulator &acc, int x, int y, Piece p, bool add) const
+{
+    for (int c = 0; c < 2; ++c)
+    {
+        const int16_t *row = &featureWeights[size_t(feature(c, x, y, p)) * HIDDEN];
+#ifdef GOMOKU_X86
+        if (vectorized)
+        {
+            add ? addRowAvx2(acc.values[c], row) : subRowAvx2(acc.values[c], row);
+            continue;
+        }
+#endif
+        add ? addRowScalar(acc.values[c], row) : subRowScalar(acc.values[c], row);
+    }
+}
+
+int NnueNetwork::evaluate(const NnueAccumulator &acc, Piece side) const
+{
+    int s = colorIndex(side);
+    alignas(32) uint8_t input[INPUTS];
+    int32_t sums[L1_SIZE];
+#ifdef GOMOKU_X86
+    if (vectorized)
+    {
+        activateAvx2(acc.values[s], acc.values[s ^ 1], input);
+        affineAvx2(input, l1Weights.data(), sums);
+    }
+    else
+#endif
+    {
+        activateScalar(acc.values[s], acc.values[s ^ 1], input);
+        affineScalar(input, l1Weights.data(), sums);
+    }
+
+    int64_t output = outputBias;
+    for (int o = 0; o < L1_SIZE; ++o)
+    {
+        // 右移 WEIGHT_SHIFT 位去掉 L1 权重的缩放，回到与输入相同的量纲
+        int hidden = std::clamp((sums[o] + l1Bias[o]) >> WEIGHT_SHIFT, 0, ACTIVATION_MAX);
+        output += int64_t(hidden) * outputWeights[o];
+    }
+    // 任意 outputScale 都可能超出胜负分界，夹到静态分的合法范围内（同时避免转 int 溢出）
+    int64_t score = output * outputScale / (int64_t(ACTIVATION_MAX) << WEIGHT_SHIFT);
+    return static_cast<int>(std::clamp<int64_t>(score, -(WIN_BOUND - 1), WIN_BOUND - 1));
+}
@@ -0,0 +1,80 @@
+#ifndef NNUE_H
+#define NNUE_H
+
+#include "Bitboard.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct NnueAccumulator;
+
+/**
+ * @brief 可增量更新的神经网络评估（NNUE）
+ *
+ * 网络结构：
+ *   输入 2 × 361 个特征：每个交叉点上的“己方子”与“对方子”（按 19 路编号，小棋盘只用左上部分）；
+ *   特征变换层 HIDDEN 个 int16，黑白两个视角各有一份累加器；
+ *   走子方与对方视角拼接并截断到 [0, 127]，得到 2 × HIDDEN 个 uint8；
+ *   L1 全连接（int8 权重）输出 L1_SIZE 个，右移 6 位后截断到 [0, 127]；
+ *   输出层（int8 权重）得到一个分数，按 outputScale 换算到与棋形评估相同的量纲。
+ * 一步落子/提子只需在两个累加器上各加减一行特征权重；推理在支持 AVX2 的 CPU 上走向量内核，
+ * 否则走标量实现，两者结果完全一致。
+ *
+ * 权重文件（小端）：
+ *   Header { char magic[8] = "GMKNNUE1"; uint32 version; uint32 hidden; uint32 l1; int32 outputScale; }
+ *   int16 featureBias[HIDDEN]; int16 featureWeights[FEATURES][HIDDEN];
+ *   int32 l1Bias[L1_SIZE];     int8 l1Weights[L1_SIZE][2 × HIDDEN];
+ *   int32 outputBias;          int8 outputWeights[L1_SIZE];
+ * 量化约定：特征层按 127 倍、L1 与输出层权重按 64 倍缩放，偏置按各自输入与权重缩放之积。
+ */
+class NnueNetwork
+{
+public:
+    static constexpr uint32_t VERSION = 1;
+    static constexpr int HIDDEN = 128;
+    static constexpr int L1_SIZE = 32;
+    static constexpr int SQUARES = BoardBits::MAX_SIZE * BoardBits::MAX_SIZE;
+    static constexpr int FEATURES = 2 * SQUARES;
+    static constexpr int ACTIVATION_MAX = 127; // 截断上限，即特征层的量化倍数
+    static constexpr int WEIGHT_SHIFT = 6;     // L1 与输出层权重的量化倍数 2^6
+
+    // 加载权重文件，失败时保持未加载状态
+    bool load(const std::string &path);
+    bool isLoaded() const { return loaded; }
+
+    // 是否使用 AVX2 内核（默认按 CPU 检测），CPU 不支持时返回 false 且不改变设置
+    bool setVectorized(bool enabled);
+
+    // 从零计算累加器
+    void refresh(NnueAccumulator &acc, const Bitboard &board) const;
+    void addStone(NnueAccumulator &acc, int x, int y, Piece p) const;
+    void removeStone(NnueAccumulator &acc, int x, int y, Piece p) const;
+
+    // 从 side 方视角的局面分
+    int evaluate(const NnueAccumulator &acc, Piece side) const;
+
+private:
+    // 视角 perspective 下，p 方在 (x, y) 的棋子对应的特征
+    static int feature(int perspective, int x, int y, Piece p);
+    void update(NnueAccumulator &acc, int x, int y, Piece p, bool add) const;
+
+    bool loaded = false;
+    bool vectorized = false;
+    int32_t outputScale = 1;
+    std::vector<int16_t> featureBias;    // [HIDDEN]
+    std::vector<int16_t> featureWeights; // [FEATURES][HIDDEN]
+    std::vector<int32_t> l1Bias;         // [L1_SIZE]
+    std::vector<int8_t> l1Weights;       // [L1_SIZE][2 * HIDDEN]
+    int32_t outputBias = 0;
+    std::vector<int8_t> outputWeights;   // [L1_SIZE]
+};
+
+/**
+ * @brief NNUE 累加器：values[c] 为以 c 方（0 黑 1 白）为“己方”的特征变换层输出
+ */
+struct NnueAccumulator
+{
+    alignas(32) int16_t values[2][NnueNetwork::HIDDEN];
+};
+
+#endif // NNUE_H
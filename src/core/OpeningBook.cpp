@@ -0,0 +1,259 @@
+#include "OpeningBook.h"
+#include "GameConfig.h"
+#include "Zobrist.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace BoardBits;
+
+namespace
+{
+    constexpr char MAGIC[8] = {'G', 'M', 'K', 'B', 'O', 'O', 'K', '1'};
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t boardSize;
+        uint64_t count;
+    };
+
+    static_assert(sizeof(Header) == 24, "book header layout");
+    static_assert(sizeof(OpeningBook::Entry) == 16, "book entry layout");
+
+    // 解析 Game::serialize 格式的着法部分："p,x,y;p,x,y;..."
+    std::vector<std::pair<int, int>> parseRecord(const std::string &record)
+    {
+        std::vector<std::pair<int, int>> moves;
+        size_t sep = record.find("||");
+        std::stringstream ss(sep == std::string::npos ? record : record.substr(sep + 2));
+        std::string item;
+        while (std::getline(ss, item, ';'))
+        {
+            int p, x, y;
+            char c1, c2;
+            std::istringstream is(item);
+            if (is >> p >> c1 >> x >> c2 >> y && c1 == ',' && c2 == ',')
+                moves.push_back({x, y});
+        }
+        return moves;
+    }
+}
+
+OpeningBook::~OpeningBook()
+{
+    close();
+}
+
+bool OpeningBook::open(const std::string &path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(Header))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    fileHandle = file;
+    mappingHandle = mapping;
+    viewSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(Header))
+    {
+        close();
+        return false;
+    }
+    viewSize = static_cast<size_t>(st.st_size);
+    view = mmap(nullptr, viewSize, PROT_READ, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED)
+        view = nullptr;
+#endif
+    if (!view)
+    {
+        close();
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, view, sizeof(header));
+    // 以除法比较条目数，损坏的 count 不会因乘法溢出而通过检查
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.boardSize < uint32_t(GameConfig::MIN_BOARD_SIZE) || header.boardSize > uint32_t(GameConfig::MAX_BOARD_SIZE) ||
+        header.count > (viewSize - sizeof(Header)) / sizeof(Entry))
+    {
+        close();
+        return false;
+    }
+
+    size = static_cast<int>(header.boardSize);
+    count = static_cast<size_t>(header.count);
+    entries = reinterpret_cast<const Entry *>(static_cast<const char *>(view) + sizeof(Header));
+    return true;
+}
+
+void OpeningBook::close()
+{
+#ifdef _WIN32
+    if (view)
+        UnmapViewOfFile(view);
+    if (mappingHandle)
+        CloseHandle(mappingHandle);
+    if (fileHandle)
+        CloseHandle(fileHandle);
+    mappingHandle = fileHandle = nullptr;
+#else
+    if (view)
+        munmap(view, viewSize);
+    if (fd >= 0)
+        ::close(fd);
+    fd = -1;
+#endif
+    view = nullptr;
+    viewSize = 0;
+    entries = nullptr;
+    count = 0;
+    size = 0;
+}
+
+int OpeningBook::transformIndex(int idx, int transform, int n)
+{
+    int x = toX(idx), y = toY(idx);
+    int tx = x, ty = y;
+    switch (transform)
+    {
+    case 0: tx = x;         ty = y;         break;
+    case 1: tx = n - 1 - x; ty = y;         break;
+    case 2: tx = x;         ty = n - 1 - y; break;
+    case 3: tx = n - 1 - x; ty = n - 1 - y; break;
+    case 4: tx = y;         ty = x;         break;
+    case 5: tx = n - 1 - y; ty = x;         break;
+    case 6: tx = y;         ty = n - 1 - x; break;
+    case 7: tx = n - 1 - y; ty = n - 1 - x; break;
+    }
+    return index(tx, ty);
+}
+
+int OpeningBook::inverseTransform(int transform)
+{
+    // 除两个 90° 旋转互逆外，其余变换都是自身的逆
+    if (transform == 5)
+        return 6;
+    if (transform == 6)
+        return 5;
+    return transform;
+}
+
+uint64_t OpeningBook::canonicalKey(const Bitboard &board, int &transform)
+{
+    uint64_t keys[8] = {};
+    for (Piece p : {Piece::BLACK, Piece::WHITE})
+    {
+        board.stones(p).forEach([&](int idx)
+                                {
+            for (int t = 0; t < 8; ++t)
+                keys[t] ^= Zobrist::key(p, transformIndex(idx, t, board.size())); });
+    }
+    transform = int(std::min_element(keys, keys + 8) - keys);
+    return keys[transform];
+}
+
+std::pair<int, int> OpeningBook::probe(const Bitboard &board) const
+{
+    if (!entries || board.size() != size)
+        return {-1, -1};
+
+    int transform = 0;
+    uint64_t key = canonicalKey(board, transform);
+    const Entry *end = entries + count;
+    const Entry *it = std::lower_bound(entries, end, key, [](const Entry &e, uint64_t k)
+                                       { return e.key < k; });
+
+    // 同一局面的条目按权重降序排列，取第一个仍为空的着法（防止键碰撞给出非法着法）
+    int inverse = inverseTransform(transform);
+    for (; it != end && it->key == key; ++it)
+    {
+        int move = transformIndex(it->move, inverse, size);
+        int x = toX(move), y = toY(move);
+        if (board.inBoard(x, y) && board.isEmpty(x, y))
+            return {x, y};
+    }
+    return {-1, -1};
+}
+
+bool OpeningBook::build(const std::vector<std::string> &records, int boardSize, int maxPly, int minCount,
+                        const std::string &path)
+{
+    std::map<std::pair<uint64_t, int>, uint32_t> counts;
+    for (const std::string &record : records)
+    {
+        Bitboard board(boardSize);
+        Piece side = Piece::BLACK;
+        auto moves = parseRecord(record);
+        for (int ply = 0; ply < std::min<int>(maxPly, moves.size()); ++ply)
+        {
+            int x = moves[ply].first, y = moves[ply].second;
+            if (!board.inBoard(x, y) || !board.isEmpty(x, y))
+                break;
+            int transform = 0;
+            uint64_t key = canonicalKey(board, transform);
+            ++counts[{key, transformIndex(index(x, y), transform, boardSize)}];
+            board.place(x, y, side);
+            side = opponent(side);
+        }
+    }
+
+    std::vector<Entry> entries;
+    for (const auto &kv : counts)
+    {
+        if (kv.second < static_cast<uint32_t>(minCount))
+            continue;
+        Entry e{};
+        e.key = kv.first.first;
+        e.move = static_cast<uint16_t>(kv.first.second);
+        e.weight = static_cast<uint16_t>(std::min<uint32_t>(kv.second, 0xFFFF));
+        entries.push_back(e);
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b)
+              { return a.key != b.key ? a.key < b.key : a.weight > b.weight; });
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.boardSize = static_cast<uint32_t>(boardSize);
+    header.count = entries.size();
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(Entry));
+    return static_cast<bool>(out);
+}
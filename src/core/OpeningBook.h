@@ -0,0 +1,74 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include "Bitboard.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 开局库
+ *
+ * 文件格式（小端）：
+ *   Header { char magic[8] = "GMKBOOK1"; uint32 version; uint32 boardSize; uint64 count; }
+ *   Entry[count] { uint64 key; uint16 move; uint16 weight; uint32 reserved; }，按 (key, weight 降序) 排列
+ * key 为局面在 8 种对称变换下 Zobrist 键的最小值，move 为该规范朝向下的位平面索引，
+ * 因此同一局面的所有旋转/镜像共用一组条目。
+ * 查询时把文件整体内存映射后二分查找，只有被访问到的页会读入内存。
+ */
+class OpeningBook
+{
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    struct Entry
+    {
+        uint64_t key;
+        uint16_t move;
+        uint16_t weight;
+        uint32_t reserved;
+    };
+
+    OpeningBook() = default;
+    ~OpeningBook();
+    OpeningBook(const OpeningBook &) = delete;
+    OpeningBook &operator=(const OpeningBook &) = delete;
+
+    // 映射开局库文件，格式不符或尺寸不同时返回 false
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const { return entries != nullptr; }
+    int boardSize() const { return size; }
+    size_t entryCount() const { return count; }
+
+    // 查询当前局面，命中时返回权重最高的着法，否则返回 (-1, -1)
+    std::pair<int, int> probe(const Bitboard &board) const;
+
+    // 由对局记录（Game::serialize 格式）生成开局库：统计每局前 maxPly 手，出现次数不足 minCount 的着法丢弃
+    static bool build(const std::vector<std::string> &records, int boardSize, int maxPly, int minCount,
+                      const std::string &path);
+
+private:
+    // 8 种对称变换下的最小键，并给出取到最小值的变换编号
+    static uint64_t canonicalKey(const Bitboard &board, int &transform);
+    static int transformIndex(int idx, int transform, int n);
+    static int inverseTransform(int transform);
+
+    const Entry *entries = nullptr;
+    size_t count = 0;
+    int size = 0;
+
+    // 平台相关的映射句柄
+    void *view = nullptr;
+    size_t viewSize = 0;
+#ifdef _WIN32
+    void *fileHandle = nullptr;
+    void *mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+#endif // OPENINGBOOK_H
@@ -0,0 +1,142 @@
+#include "PatternBatch.h"
+#include "CpuFeatures.h"
+#include "EvalWeights.h"
+#include "PatternTable.h"
+#include <atomic>
+
+#ifdef GOMOKU_X86
+#include <immintrin.h>
+#endif
+
+using namespace BoardBits;
+
+namespace
+{
+    void scoreScalar(const Bitboard &board, const int16_t *cells, int count, Piece side, int32_t *scores)
+    {
+        const PatternTable &table = PatternTable::instance();
+        const BoardGeometry &geo = board.geometry();
+        int s = colorIndex(side);
+        for (int i = 0; i < count; ++i)
+        {
+            int idx = cells[i];
+            int attack = 0, defense = 0;
+            for (int d = 0; d < DIRS; ++d)
+            {
+                int l = geo.line[d][idx];
+                int pos = geo.pos[d][idx];
+                uint32_t mine = board.lineWord(s, d, l);
+                uint32_t theirs = board.lineWord(s ^ 1, d, l);
+                uint32_t outside = ~geo.lineMask[d][l];
+                uint32_t mineWindow = (mine >> pos) & 0x7F;
+                uint32_t theirsWindow = (theirs >> pos) & 0x7F;
+                uint32_t outsideWindow = (outside >> pos) & 0x7F;
+                attack += table.score(table.encode(mineWindow, theirsWindow | outsideWindow));
+                defense += table.score(table.encode(theirsWindow, mineWindow | outsideWindow));
+            }
+            scores[i] = attack + defense * EvalWeights::DEFENSE_WEIGHT;
+        }
+    }
+
+#ifdef GOMOKU_X86
+    GOMOKU_TARGET_AVX2 void scoreAvx2(const Bitboard &board, const int16_t *cells, int count, Piece side,
+                                     int32_t *scores)
+    {
+        const PatternTable &table = PatternTable::instance();
+        const BoardGeometry &geo = board.geometry();
+        const int32_t *ternary = table.ternaryData();
+        const int32_t *patternScores = table.scoreData();
+        int s = colorIndex(side);
+
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        const __m256i windowMask = _mm256_set1_epi32(0x7F);
+        const __m256i defenseWeight = _mm256_set1_epi32(EvalWeights::DEFENSE_WEIGHT);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i idx = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(cells + i)));
+            __m256i attack = _mm256_setzero_si256();
+            __m256i defense = _mm256_setzero_si256();
+            for (int d = 0; d < DIRS; ++d)
+            {
+                // 线编号与线上位置是字节表：按字节偏移收集 32 位再取低 8 位（多读的 3 字节仍在几何表内）
+                __m256i line = _mm256_and_si256(
+                    _mm256_i32gather_epi32(reinterpret_cast<const int *>(geo.line[d]), idx, 1), byteMask);
+                __m256i pos = _mm256_and_si256(
+                    _mm256_i32gather_epi32(reinterpret_cast<const int *>(geo.pos[d]), idx, 1), byteMask);
+
+                __m256i mine = _mm256_i32gather_epi32(reinterpret_cast<const int *>(board.lineWords(s, d)), line, 4);
+                __m256i theirs =
+                    _mm256_i32gather_epi32(reinterpret_cast<const int *>(board.lineWords(s ^ 1, d)), line, 4);
+                __m256i valid = _mm256_i32gather_epi32(reinterpret_cast<const int *>(geo.lineMask[d]), line, 4);
+
+                __m256i mineWindow = _mm256_and_si256(_mm256_srlv_epi32(mine, pos), windowMask);
+                __m256i theirsWindow = _mm256_and_si256(_mm256_srlv_epi32(theirs, pos), windowMask);
+                __m256i outsideWindow = _mm256_andnot_si256(_mm256_srlv_epi32(valid, pos), windowMask);
+
+                // 编码 = ternary[own] + 2 * ternary[block]，再按编码收集得分
+                __m256i mineCode = _mm256_i32gather_epi32(ternary, mineWindow, 4);
+                __m256i theirsCode = _mm256_i32gather_epi32(ternary, theirsWindow, 4);
+                __m256i mineBlock =
+                    _mm256_i32gather_epi32(ternary, _mm256_or_si256(mineWindow, outsideWindow), 4);
+                __m256i theirsBlock =
+                    _mm256_i32gather_epi32(ternary, _mm256_or_si256(theirsWindow, outsideWindow), 4);
+
+                __m256i attackCode = _mm256_add_epi32(mineCode, _mm256_slli_epi32(theirsBlock, 1));
+                __m256i defenseCode = _mm256_add_epi32(theirsCode, _mm256_slli_epi32(mineBlock, 1));
+                attack = _mm256_add_epi32(attack, _mm256_i32gather_epi32(patternScores, attackCode, 4));
+                defense = _mm256_add_epi32(defense, _mm256_i32gather_epi32(patternScores, defenseCode, 4));
+            }
+            __m256i total = _mm256_add_epi32(attack, _mm256_mullo_epi32(defense, defenseWeight));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(scores + i), total);
+        }
+        scoreScalar(board, cells + i, count - i, side, scores + i);
+    }
+
+#endif
+
+    PatternBatch::Kernel detectKernel()
+    {
+        return CpuFeatures::hasAvx2() ? PatternBatch::Kernel::Avx2 : PatternBatch::Kernel::Scalar;
+    }
+
+    std::atomic<PatternBatch::Kernel> &currentKernel()
+    {
+        static std::atomic<PatternBatch::Kernel> kernel(detectKernel());
+        return kernel;
+    }
+}
+
+namespace PatternBatch
+{
+    Kernel activeKernel()
+    {
+        return currentKernel().load(std::memory_order_relaxed);
+    }
+
+    const char *kernelName(Kernel kernel)
+    {
+        return kernel == Kernel::Avx2 ? "avx2" : "scalar";
+    }
+
+    bool setKernel(Kernel kernel)
+    {
+        if (kernel == Kernel::Avx2 && !CpuFeatures::hasAvx2())
+            return false;
+        currentKernel().store(kernel, std::memory_order_relaxed);
+        return true;
+    }
+
+    void scoreMoves(const Bitboard &board, const int16_t *cells, int count, Piece side, int32_t *scores)
+    {
+#ifdef GOMOKU_X86
+        if (activeKernel() == Kernel::Avx2)
+        {
+            scoreAvx2(board, cells, count, side, scores);
+            return;
+        }
+#endif
+        scoreScalar(board, cells, count, side, scores);
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef PATTERNBATCH_H
+#define PATTERNBATCH_H
+
+#include "Bitboard.h"
+#include <cstdint>
+
+/**
+ * @brief 批量落子打分
+ *
+ * 一次为一组空位计算 Heuristics::getMoveHeuristicScore，结果与逐点打分完全一致。
+ * AVX2 内核每次处理 8 个点：按点收集四个方向的线编号与线上位置，再收集双方的线位串，
+ * 逐通道右移取出 7 格窗口，经两次查表（二进制 -> 三进制、编码 -> 得分）得到棋形分。
+ * 首次调用时检测 CPU，不支持 AVX2（或非 x86 平台）时使用标量内核。
+ */
+namespace PatternBatch
+{
+    enum class Kernel : uint8_t
+    {
+        Scalar,
+        Avx2
+    };
+
+    Kernel activeKernel();
+    const char *kernelName(Kernel kernel);
+
+    // 强制使用指定内核（基准测试与对拍用），CPU 不支持时返回 false 且不改变当前内核
+    bool setKernel(Kernel kernel);
+
+    // cells 为 count 个空位的位平面索引；scores[i] = side 的进攻分 + 对方的防守分 × DEFENSE_WEIGHT
+    void scoreMoves(const Bitboard &board, const int16_t *cells, int count, Piece side, int32_t *scores);
+}
+
+#endif // PATTERNBATCH_H
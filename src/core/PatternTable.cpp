@@ -0,0 +1,86 @@
+#include "PatternTable.h"
+#include "EvalWeights.h"
+#include <string>
+
+namespace
+{
+    struct PatternDef
+    {
+        const char *key;
+        PatternTable::Threat threat;
+    };
+
+    // 棋形表（'1' 己方，'2' 对方或边界，'0' 空位），得分见 EvalWeights::PATTERN_SCORES
+    const PatternDef PATTERN_DEFS[] = {
+        {"11111", PatternTable::Threat::Five},         // 连五
+        {"011110", PatternTable::Threat::LiveFour},    // 活四
+        {"011112", PatternTable::Threat::Four},        // 冲四（左）
+        {"211110", PatternTable::Threat::Four},        // 冲四（右）
+        {"01110", PatternTable::Threat::Three},        // 活三
+        {"01112", PatternTable::Threat::SleepThree},   // 眠三（左）
+        {"21110", PatternTable::Threat::SleepThree},   // 眠三（右）
+        {"0011100", PatternTable::Threat::Three},      // 跳活三
+        {"010110", PatternTable::Threat::Three},       // 弯三
+        {"011010", PatternTable::Threat::Three},       // 弯三
+        {"001100", PatternTable::Threat::Two},         // 活二
+        {"001120", PatternTable::Threat::Two},         // 眠二（左）
+        {"021100", PatternTable::Threat::Two},         // 眠二（右）
+        {"01010", PatternTable::Threat::Two},          // 跳二
+        {"0010100", PatternTable::Threat::Two},        // 大跳二
+    };
+
+    static_assert(sizeof(PATTERN_DEFS) / sizeof(PATTERN_DEFS[0]) == PatternTable::PATTERNS, "pattern table size");
+    static_assert(EvalWeights::PATTERN_COUNT == PatternTable::PATTERNS, "generated weights out of date");
+}
+
+const char *PatternTable::patternKey(int i)
+{
+    return PATTERN_DEFS[i].key;
+}
+
+const PatternTable &PatternTable::instance()
+{
+    static const PatternTable table;
+    return table;
+}
+
+PatternTable::PatternTable()
+{
+    for (int mask = 0; mask < (1 << WINDOW); ++mask)
+    {
+        int value = 0, weight = 1;
+        for (int i = 0; i < WINDOW; ++i, weight *= 3)
+        {
+            if ((mask >> i) & 1)
+                value += weight;
+        }
+        ternary[mask] = value;
+    }
+
+    // 逐个编码还原窗口字符串，按原有子串匹配规则累加得分
+    std::string pattern(WINDOW, '0');
+    for (int code = 0; code < CODES; ++code)
+    {
+        int rest = code;
+        for (int i = 0; i < WINDOW; ++i, rest /= 3)
+            pattern[i] = static_cast<char>('0' + rest % 3);
+
+        int score = 0;
+        uint16_t mask = 0;
+        Threat threat = Threat::None;
+        for (int i = 0; i < PATTERNS; ++i)
+        {
+            const PatternDef &def = PATTERN_DEFS[i];
+            if (pattern.find(def.key) != std::string::npos)
+            {
+                score += EvalWeights::PATTERN_SCORES[i];
+                mask |= uint16_t(1) << i;
+                if (def.threat > threat)
+                    threat = def.threat;
+            }
+        }
+        scores[code] = score;
+        threats[code] = threat;
+        matched[code] = mask;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef PATTERNTABLE_H
+#define PATTERNTABLE_H
+
+#include <cstdint>
+
+/**
+ * @brief 棋形查表评估
+ *
+ * 把以某点为中心、某方向上的 7 格窗口编码为三进制整数（空 0 / 己方 1 / 对方或界外 2，
+ * 第 i 格权重 3^i），程序启动后首次使用时按棋形表逐一匹配生成 3^7 项的得分与威胁等级，
+ * 之后每个窗口的评估只需一次编码和一次查表，结果与逐个子串匹配完全一致。
+ */
+class PatternTable
+{
+public:
+    static constexpr int WINDOW = 7;
+    static constexpr int CODES = 2187; // 3^7
+    static constexpr int PATTERNS = 15; // 棋形表项数
+
+    // 威胁等级（取窗口内命中棋形的最高等级）
+    enum class Threat : uint8_t
+    {
+        None,
+        Two,        // 活二 / 眠二 / 跳二
+        SleepThree, // 眠三
+        Three,      // 活三 / 跳活三 / 弯三
+        Four,       // 冲四
+        LiveFour,   // 活四
+        Five        // 连五
+    };
+
+    static const PatternTable &instance();
+
+    // own / block 为窗口位掩码（低 7 位），二者不重叠
+    int encode(uint32_t own, uint32_t block) const { return ternary[own] + 2 * ternary[block]; }
+    int score(int code) const { return scores[code]; }
+    Threat threat(int code) const { return threats[code]; }
+    // 窗口命中的棋形（第 i 位对应棋形表第 i 项），离线调参时按棋形计数用
+    uint16_t matches(int code) const { return matched[code]; }
+    static const char *patternKey(int i);
+
+    // 原始表，供批量打分的向量内核按下标收集（gather）
+    const int32_t *ternaryData() const { return ternary; }
+    const int32_t *scoreData() const { return scores; }
+
+private:
+    PatternTable();
+
+    int32_t ternary[1 << WINDOW]; // 二进制掩码 -> 对应位上全为 1 的三进制数
+    int32_t scores[CODES];
+    Threat threats[CODES];
+    uint16_t matched[CODES];
+};
+
+#endif // PATTERNTABLE_H
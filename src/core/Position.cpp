@@ -0,0 +1,45 @@
+#include "Position.h"
+#include "Zobrist.h"
+
+Position::Position(const Bitboard &board) : bb(board)
+{
+    eval.init(bb);
+    cands.init(bb);
+    for (Piece p : {Piece::BLACK, Piece::WHITE})
+        bb.stones(p).forEach([&](int idx)
+                             { key ^= Zobrist::key(p, idx); });
+}
+
+void Position::makeMove(int x, int y, Piece p)
+{
+    bb.place(x, y, p);
+    if (net)
+        net->addStone(acc, x, y, p);
+    else
+        eval.onPlace(bb, x, y, p);
+    cands.onPlace(bb, x, y);
+    key ^= Zobrist::key(p, BoardBits::index(x, y));
+}
+
+void Position::unmakeMove(int x, int y)
+{
+    Piece p = bb.at(x, y);
+    if (p == Piece::EMPTY)
+        return;
+    bb.remove(x, y);
+    if (net)
+        net->removeStone(acc, x, y, p);
+    else
+        eval.onRemove(bb, x, y, p);
+    cands.onRemove(bb, x, y);
+    key ^= Zobrist::key(p, BoardBits::index(x, y));
+}
+
+void Position::setNetwork(const NnueNetwork *network)
+{
+    net = network;
+    if (net)
+        net->refresh(acc, bb);
+    else
+        eval.init(bb);
+}
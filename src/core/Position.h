@@ -0,0 +1,49 @@
+#ifndef POSITION_H
+#define POSITION_H
+
+#include "Bitboard.h"
+#include "CandidateSet.h"
+#include "Evaluator.h"
+#include "Nnue.h"
+
+/**
+ * @brief 搜索局面
+ *
+ * 把位棋盘与随之增量维护的状态（评估器、候选点集合、Zobrist 键等）绑在一起，
+ * 搜索只通过 makeMove / unmakeMove 改变局面，保证各部分始终同步。
+ * 挂接 NNUE 网络后改为增量更新网络的累加器，棋形评估器暂停维护，直到取消挂接时重算。
+ */
+class Position
+{
+public:
+    explicit Position(const Bitboard &board);
+
+    const Bitboard &board() const { return bb; }
+    const Evaluator &evaluator() const { return eval; }
+    uint64_t hash() const { return key; }
+
+    // 已有棋子周围两格内的空位
+    BitPlane candidates() const { return cands.moves(bb); }
+
+    void makeMove(int x, int y, Piece p);
+    void unmakeMove(int x, int y);
+
+    // 从 side 方视角的局面分（O(1)），挂接网络期间不可用
+    int evaluate(Piece side) const { return eval.evaluate(side); }
+
+    // 挂接已加载的 NNUE 网络（为空则取消），按当前棋盘重算累加器或棋形评估；网络须比局面存活更久
+    void setNetwork(const NnueNetwork *network);
+    bool hasNetwork() const { return net != nullptr; }
+    // 从 side 方视角的 NNUE 局面分，须先挂接网络
+    int evaluateNnue(Piece side) const { return net->evaluate(acc, side); }
+
+private:
+    Bitboard bb;
+    Evaluator eval;
+    CandidateSet cands;
+    uint64_t key = 0;
+    const NnueNetwork *net = nullptr;
+    NnueAccumulator acc;
+};
+
+#endif // POSITION_H
@@ -0,0 +1,355 @@
+#include "ProofSolver.h"
+#include "Threats.h"
+#include "Zobrist.h"
+#include "Timer.hpp"
+#include <algorithm>
+
+using namespace BoardBits;
+
+namespace
+{
+    constexpr uint64_t SALT_WHITE = 0xD6E8FEB86659FD93ULL;
+    constexpr uint64_t SALT_AND = 0xA0761D6478BD642FULL;
+
+    // 占用超过 GC_FILL 时回收，回收到 GC_TARGET 以下为止
+    constexpr double GC_FILL = 0.9;
+    constexpr double GC_TARGET = 0.6;
+
+    Piece pieceOf(int color) { return color ? Piece::WHITE : Piece::BLACK; }
+
+    uint32_t saturatingAdd(uint32_t a, uint32_t b, uint32_t limit)
+    {
+        return a >= limit - std::min(b, limit) ? limit : a + b;
+    }
+}
+
+ProofSolver::ProofSolver(int megabytes)
+{
+    setMemoryLimit(megabytes);
+}
+
+void ProofSolver::setMemoryLimit(int megabytes)
+{
+    size_t entries = (size_t(std::max(1, megabytes)) << 20) / sizeof(Node);
+    size_t clusters = 1;
+    while (clusters * 2 * CLUSTER <= entries)
+        clusters *= 2;
+    table.assign(clusters * CLUSTER, Node{});
+    clusterMask = clusters - 1;
+    used = 0;
+}
+
+void ProofSolver::clear()
+{
+    std::fill(table.begin(), table.end(), Node{});
+    used = 0;
+}
+
+ProofSolver::Result ProofSolver::solve(const Bitboard &board, Piece side)
+{
+    Result result = prove(board, side, side);
+    if (result.status != Status::Unknown || exhausted())
+        return result;
+
+    // 剩余预算用于证明对方必胜
+    uint64_t spent = result.nodes;
+    uint64_t limit = nodeLimit;
+    nodeLimit = limit - spent;
+    Result loss = prove(board, opponent(side), side);
+    nodeLimit = limit;
+    loss.nodes += spent;
+    loss.collections += result.collections;
+    return loss;
+}
+
+ProofSolver::Result ProofSolver::prove(const Bitboard &board, Piece attacker, Piece toMove)
+{
+    bb = board;
+    key = 0;
+    for (Piece p : {Piece::BLACK, Piece::WHITE})
+        bb.stones(p).forEach([&](int idx)
+                             { key ^= Zobrist::key(p, idx); });
+    att = colorIndex(attacker);
+    def = att ^ 1;
+    nodes = 0;
+    collections = 0;
+    timedOut = false;
+
+    bool orNode = toMove == attacker;
+    mid(INF, INF, orNode, 0);
+
+    Result result;
+    const Node *root = lookup(nodeKey(orNode));
+    if (root && root->pn == 0)
+    {
+        result.status = orNode ? Status::Win : Status::Loss;
+        if (orNode && root->move >= 0)
+        {
+            result.x = toX(root->move);
+            result.y = toY(root->move);
+        }
+    }
+    result.nodes = nodes;
+    result.storedNodes = used;
+    result.collections = collections;
+    return result;
+}
+
+uint64_t ProofSolver::nodeKey(bool orNode) const
+{
+    return key ^ (orNode ? 0 : SALT_AND) ^ (att ? SALT_WHITE : 0);
+}
+
+void ProofSolver::place(int idx, int color)
+{
+    bb.place(toX(idx), toY(idx), pieceOf(color));
+    key ^= Zobrist::key(pieceOf(color), idx);
+}
+
+void ProofSolver::lift(int idx, int color)
+{
+    bb.remove(toX(idx), toY(idx));
+    key ^= Zobrist::key(pieceOf(color), idx);
+}
+
+bool ProofSolver::exhausted() const
+{
+    return nodes >= nodeLimit || timedOut || (stopFlag && stopFlag->load(std::memory_order_relaxed));
+}
+
+void ProofSolver::mid(uint32_t thPn, uint32_t thDn, bool orNode, int ply)
+{
+    uint64_t start = nodes++;
+    uint64_t k = nodeKey(orNode);
+    if (deadline && nodes % STOP_CHECK_INTERVAL == 0 && GetTimeMS() >= deadline)
+        timedOut = true;
+
+    int16_t moves[CELLS];
+    uint32_t pn = 1, dn = 1;
+    int winMove = -1;
+    int count = 0;
+    if (ply >= MAX_PLY)
+    {
+        // 超过最大层数按证伪处理（只会使结果更保守）
+        pn = INF;
+        dn = 0;
+        count = -1;
+    }
+    else
+    {
+        count = generate(orNode, moves, pn, dn, winMove);
+    }
+    if (count < 0)
+    {
+        store(k, pn, dn, 1, winMove);
+        return;
+    }
+
+    int mover = orNode ? att : def;
+    int bestIdx = 0;
+    while (true)
+    {
+        // 由子节点汇总：OR 节点 pn 取最小、dn 求和；AND 节点反之
+        bestIdx = 0;
+        uint32_t bestValue = INF + 1, second = INF;
+        uint32_t bestPn = 1, bestDn = 1;
+        uint32_t minimum = INF, sum = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            key ^= Zobrist::key(pieceOf(mover), moves[i]);
+            const Node *child = lookup(nodeKey(!orNode));
+            key ^= Zobrist::key(pieceOf(mover), moves[i]);
+            uint32_t cpn = child ? child->pn : 1;
+            uint32_t cdn = child ? child->dn : 1;
+
+            uint32_t value = orNode ? cpn : cdn;
+            minimum = std::min(minimum, value);
+            sum = saturatingAdd(sum, orNode ? cdn : cpn, INF);
+            if (value < bestValue)
+            {
+                second = std::min(second, bestValue);
+                bestValue = value;
+                bestIdx = i;
+                bestPn = cpn;
+                bestDn = cdn;
+            }
+            else if (value < second)
+            {
+                second = value;
+            }
+        }
+        pn = orNode ? minimum : sum;
+        dn = orNode ? sum : minimum;
+
+        if (pn >= thPn || dn >= thDn || exhausted())
+            break;
+
+        // 子节点阈值：选中子节点要么超过次优兄弟，要么耗尽本节点剩余的阈值
+        uint32_t childPn, childDn;
+        if (orNode)
+        {
+            childPn = std::min(thPn, second + 1);
+            childDn = std::min(INF, thDn - dn + bestDn);
+        }
+        else
+        {
+            childDn = std::min(thDn, second + 1);
+            childPn = std::min(INF, thPn - pn + bestPn);
+        }
+
+        place(moves[bestIdx], mover);
+        mid(childPn, childDn, !orNode, ply + 1);
+        lift(moves[bestIdx], mover);
+    }
+
+    // 证明时记下 pn 为 0 的子节点；其余情况记下最有希望的子节点
+    winMove = moves[bestIdx];
+    if (orNode && pn == 0)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            key ^= Zobrist::key(pieceOf(mover), moves[i]);
+            const Node *child = lookup(nodeKey(false));
+            key ^= Zobrist::key(pieceOf(mover), moves[i]);
+            if (child && child->pn == 0)
+            {
+                winMove = moves[i];
+                break;
+            }
+        }
+    }
+    store(k, pn, dn, nodes - start, winMove);
+}
+
+int ProofSolver::generate(bool orNode, int16_t *moves, uint32_t &pn, uint32_t &dn, int &winMove)
+{
+    auto proven = [&]
+    {
+        pn = 0;
+        dn = INF;
+        return -1;
+    };
+    auto disproven = [&]
+    {
+        pn = INF;
+        dn = 0;
+        return -1;
+    };
+
+    int me = orNode ? att : def;
+    int other = me ^ 1;
+
+    // 走子方可直接成五
+    BitPlane ownFives = Threats::windowCells(bb, me, 4);
+    if (ownFives.any())
+    {
+        ownFives.forEach([&](int idx)
+                         { if (winMove < 0) winMove = idx; });
+        return orNode ? proven() : disproven();
+    }
+
+    // 对方有成五点：两个以上挡不住，一个则只能去挡
+    int count = 0;
+    BitPlane otherFives = Threats::windowCells(bb, other, 4);
+    int fives = otherFives.count();
+    if (fives >= 2)
+        return orNode ? disproven() : proven();
+    if (fives == 1)
+    {
+        otherFives.forEach([&](int idx)
+                           { moves[count++] = static_cast<int16_t>(idx); });
+        return count;
+    }
+
+    BitPlane attackerFours = Threats::windowCells(bb, att, 3);
+    if (orNode)
+    {
+        // 攻方：冲四，以及落子后形成活四威胁的活三
+        attackerFours.forEach([&](int idx)
+                              { moves[count++] = static_cast<int16_t>(idx); });
+        Threats::windowCells(bb, att, 2).andNot(attackerFours).forEach([&](int idx)
+                                                                     {
+            bb.place(toX(idx), toY(idx), pieceOf(att));
+            if (Threats::threatCells(bb, att, idx).any())
+                moves[count++] = static_cast<int16_t>(idx);
+            bb.remove(toX(idx), toY(idx)); });
+        return count > 0 ? count : disproven();
+    }
+
+    // 守方：攻方已经没有活四的后续，上一手不是强制着法
+    bool threat = false;
+    attackerFours.forEach([&](int idx)
+                          { threat = threat || Threats::makesLiveFour(bb, att, idx); });
+    if (!threat)
+        return disproven();
+
+    // 能阻止活四的点都在攻方的三子窗口里；守方冲四作为反击
+    (attackerFours | Threats::windowCells(bb, def, 3)).forEach([&](int idx)
+                                                              { moves[count++] = static_cast<int16_t>(idx); });
+    return count;
+}
+
+const ProofSolver::Node *ProofSolver::lookup(uint64_t k) const
+{
+    const Node *cluster = &table[(k & clusterMask) * CLUSTER];
+    for (int i = 0; i < CLUSTER; ++i)
+    {
+        if (cluster[i].work && cluster[i].key == k)
+            return &cluster[i];
+    }
+    return nullptr;
+}
+
+void ProofSolver::store(uint64_t k, uint32_t pn, uint32_t dn, uint64_t work, int move)
+{
+    Node *cluster = &table[(k & clusterMask) * CLUSTER];
+    Node *slot = nullptr;
+    for (int i = 0; i < CLUSTER && !slot; ++i)
+    {
+        if (cluster[i].work && cluster[i].key == k)
+            slot = &cluster[i];
+    }
+    for (int i = 0; i < CLUSTER && !slot; ++i)
+    {
+        if (!cluster[i].work)
+        {
+            slot = &cluster[i];
+            ++used;
+        }
+    }
+    if (!slot)
+    {
+        // 簇已满：替换工作量最小的项
+        slot = std::min_element(cluster, cluster + CLUSTER, [](const Node &a, const Node &b)
+                                { return a.work < b.work; });
+    }
+
+    uint32_t w = static_cast<uint32_t>(std::min<uint64_t>(work, UINT32_MAX));
+    if (slot->work && slot->key == k)
+        w = std::max(w, slot->work);
+    *slot = {k, pn, dn, std::max<uint32_t>(w, 1), static_cast<int16_t>(move), 0};
+
+    if (used > table.size() * GC_FILL)
+        collect();
+}
+
+void ProofSolver::collect()
+{
+    // 门槛逐次翻倍，先清除工作量小的未解决项；已证明/证伪的项按 4 倍工作量计，尽量保留
+    ++collections;
+    size_t target = static_cast<size_t>(table.size() * GC_TARGET);
+    for (uint64_t threshold = 1; used > target; threshold *= 2)
+    {
+        for (Node &n : table)
+        {
+            if (!n.work)
+                continue;
+            uint64_t weight = (n.pn == 0 || n.dn == 0) ? uint64_t(n.work) * 4 : n.work;
+            if (weight <= threshold)
+            {
+                n = Node{};
+                --used;
+            }
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef PROOFSOLVER_H
+#define PROOFSOLVER_H
+
+#include "Bitboard.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 证明数搜索（df-pn）求解器
+ *
+ * 在威胁空间内证明“攻方必胜”：
+ *   - 攻方节点（OR）：直接成五即证明；对方有成五点时只能去挡；否则走冲四或活三；
+ *   - 守方节点（AND）：守方能成五即证伪；攻方有两个成五点即证明、一个则必须挡；
+ *     攻方已没有活四/成五的后续即证伪（攻方上一手不是强制着法）；否则守方的应手为
+ *     攻方所有三子窗口中的空位（覆盖一切能阻止活四的点）加上守方自己的冲四。
+ * 守方应手集合是完备的，所以证明结果可靠；证伪只说明威胁空间内没有胜法。
+ *
+ * 节点表按簇（4 路组相联）存放 (键, 证明数, 反证数, 工作量, 最佳着法)，每项 24 字节，
+ * 容量由内存预算决定。簇满时替换工作量最小的项；表的占用超过上限时做一次垃圾回收，
+ * 逐步提高工作量门槛清除未解决的小子树，直到占用降到目标以下。
+ */
+class ProofSolver
+{
+public:
+    enum class Status : uint8_t
+    {
+        Unknown, // 预算内未能证明
+        Win,     // 走子方必胜
+        Loss     // 走子方必败（对方在威胁空间内必胜）
+    };
+
+    struct Result
+    {
+        Status status = Status::Unknown;
+        int x = -1, y = -1; // 必胜时的第一手
+        uint64_t nodes = 0;
+        size_t storedNodes = 0; // 结束时节点表中的项数
+        int collections = 0;    // 垃圾回收次数
+    };
+
+    explicit ProofSolver(int megabytes = 16);
+
+    // 重新分配节点表（清空已有内容）
+    void setMemoryLimit(int megabytes);
+    void setNodeLimit(uint64_t limit) { nodeLimit = limit; }
+    // 外部中止标志（可为空），置位后尽快返回 Unknown
+    void setStopFlag(const std::atomic<bool> *flag) { stopFlag = flag; }
+    // 截止时刻（GetTimeMS 时基，0 为不限），每 STOP_CHECK_INTERVAL 个节点检查一次，到达后同样返回 Unknown
+    void setDeadline(uint64_t timeMs) { deadline = timeMs; }
+    void clear();
+
+    // 先证明 side 方必胜，不成再证明对方必胜（即 side 方必败），共用同一节点预算
+    Result solve(const Bitboard &board, Piece side);
+
+    // 证明 attacker 在 toMove 先走时必胜
+    Result prove(const Bitboard &board, Piece attacker, Piece toMove);
+
+private:
+    static constexpr uint32_t INF = 0x3FFFFFFF;
+    static constexpr int CLUSTER = 4;
+    static constexpr int MAX_PLY = 64;
+    static constexpr uint64_t STOP_CHECK_INTERVAL = 256;
+
+    struct Node
+    {
+        uint64_t key;
+        uint32_t pn;
+        uint32_t dn;
+        uint32_t work;   // 该节点子树的累计展开次数，0 表示空项
+        int16_t move;    // 最佳子节点（证明时为胜着）
+        uint16_t unused;
+    };
+
+    void mid(uint32_t thPn, uint32_t thDn, bool orNode, int ply);
+
+    // 生成子节点着法；局面已分胜负时返回 -1 并在 pn/dn 中给出结果
+    int generate(bool orNode, int16_t *moves, uint32_t &pn, uint32_t &dn, int &winMove);
+
+    const Node *lookup(uint64_t k) const;
+    void store(uint64_t k, uint32_t pn, uint32_t dn, uint64_t work, int move);
+    void collect();
+
+    uint64_t nodeKey(bool orNode) const;
+    void place(int idx, int color);
+    void lift(int idx, int color);
+    bool exhausted() const;
+
+    Bitboard bb;
+    uint64_t key = 0;
+    int att = 0, def = 1;
+    uint64_t nodes = 0;
+    uint64_t nodeLimit = 200000;
+    const std::atomic<bool> *stopFlag = nullptr;
+    uint64_t deadline = 0;
+    bool timedOut = false;
+
+    std::vector<Node> table;
+    uint64_t clusterMask = 0;
+    size_t used = 0;
+    int collections = 0;
+};
+
+#endif // PROOFSOLVER_H
@@ -0,0 +1,76 @@
+#ifndef SEARCHTYPES_H
+#define SEARCHTYPES_H
+
+#include "GameConfig.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// 分数范围：成五为 WIN_SCORE - 层数，绝对值不小于 WIN_BOUND 的都是胜负已定的分数；
+// 静态评估必须落在 (-WIN_BOUND, WIN_BOUND) 内，否则会被置换表当作杀棋距离调整
+constexpr int SCORE_INF = 10000000;
+constexpr int WIN_SCORE = 1000000;
+constexpr int WIN_BOUND = WIN_SCORE - 1000;
+
+/**
+ * @brief 单步搜索的限制条件
+ *
+ * timeMs 为 0 时由 TimeManager 根据棋钟分配时间；nodes 为 0 表示不限节点数。
+ */
+struct SearchLimits
+{
+    int timeMs = 0;                                // 本步固定用时（毫秒）
+    uint64_t nodes = 0;                            // 节点上限
+    int maxDepth = GameConfig::DEFAULT_AI_MAX_DEPTH; // 迭代加深最大深度
+};
+
+/**
+ * @brief 叶节点评估函数
+ */
+enum class EvalKind : uint8_t
+{
+    Pattern, // 棋形表增量评估
+    Nnue     // 神经网络评估（须先加载权重）
+};
+
+/**
+ * @brief 单个搜索线程在一步思考中的统计
+ */
+struct ThreadStats
+{
+    int id = 0;         // 线程编号，0 为主线程
+    uint64_t nodes = 0; // 搜索节点数
+    int depth = 0;      // 完成的最大迭代深度
+    uint64_t nps = 0;   // 每秒节点数
+};
+
+/**
+ * @brief 一步（或一轮迭代）搜索的统计
+ *
+ * 比率类字段在没有样本时为 0；用时分解只在开启计时（AiPlayer::setProfiling）时统计。
+ */
+struct SearchStats
+{
+    int depth = 0;       // 完成的迭代深度
+    int seldepth = 0;    // 实际到达的最大层数
+    int score = 0;       // 根节点分数（AI 视角）
+    int timeMs = 0;      // 用时（毫秒）
+    uint64_t nodes = 0;  // 主搜索节点数（所有线程）
+    uint64_t qnodes = 0; // 其中在深度 0 直接评估的叶节点数
+    uint64_t nps = 0;    // 每秒节点数
+    uint64_t threatNodes = 0; // VCF/VCT 预检与证明数搜索的节点数
+
+    double firstMoveCutoffRate = 0; // 发生剪枝的节点中，第一个着法即剪枝的比例
+    double ttHitRate = 0;           // 置换表命中率
+    double threatCacheHitRate = 0;  // VCF/VCT 证明缓存命中率
+    double branchingFactor = 0;     // 内部节点平均实际搜索的着法数
+
+    std::vector<std::pair<int, int>> pv; // 主变例，首项为本步着法
+
+    uint64_t movegenUs = 0; // 着法生成用时（微秒）
+    uint64_t evalUs = 0;    // 评估用时（含落子/撤销时的增量更新，微秒）
+
+    bool final = false; // true 为整步结束时的统计，false 为某轮迭代的中间统计
+};
+
+#endif // SEARCHTYPES_H
@@ -0,0 +1,236 @@
+#include "ThreatSolver.h"
+#include "Threats.h"
+#include "Zobrist.h"
+#include "Timer.hpp"
+#include <algorithm>
+
+using namespace BoardBits;
+
+namespace
+{
+    constexpr uint64_t SALT_WHITE = 0x9E3779B97F4A7C15ULL;
+    constexpr uint64_t SALT_VCT = 0xC2B2AE3D27D4EB4FULL;
+
+    Piece pieceOf(int color) { return color ? Piece::WHITE : Piece::BLACK; }
+}
+
+ThreatSolver::ThreatSolver(int cacheBits)
+    : cache(size_t(1) << cacheBits), cacheMask((uint64_t(1) << cacheBits) - 1) {}
+
+ThreatSolver::Result ThreatSolver::solve(const Bitboard &board, Piece attacker, Mode searchMode, int maxDepth)
+{
+    bb = board;
+    key = 0;
+    for (Piece p : {Piece::BLACK, Piece::WHITE})
+        bb.stones(p).forEach([&](int idx)
+                             { key ^= Zobrist::key(p, idx); });
+    att = colorIndex(attacker);
+    def = att ^ 1;
+    mode = searchMode;
+    nodes = 0;
+    stopped = false;
+    cacheProbes = cacheHits = 0;
+
+    // 逐步加深，优先找到最短的胜法
+    Result result;
+    for (int depth = 1; depth <= maxDepth && nodes < nodeLimit && !stopped; ++depth)
+    {
+        int move = -1;
+        if (attack(depth, &move) && move >= 0)
+        {
+            result.win = true;
+            result.x = toX(move);
+            result.y = toY(move);
+            result.depth = depth;
+            break;
+        }
+    }
+    result.nodes = nodes;
+    result.cacheProbes = cacheProbes;
+    result.cacheHits = cacheHits;
+    return result;
+}
+
+bool ThreatSolver::tick()
+{
+    if (++nodes % STOP_CHECK_INTERVAL == 0 && !stopped)
+        stopped = (stopFlag && stopFlag->load(std::memory_order_relaxed)) || (deadline && GetTimeMS() >= deadline);
+    return exhausted();
+}
+
+uint64_t ThreatSolver::cacheKey() const
+{
+    return key ^ (att ? SALT_WHITE : 0) ^ (mode == Mode::VCT ? SALT_VCT : 0);
+}
+
+void ThreatSolver::place(int idx, int color)
+{
+    bb.place(toX(idx), toY(idx), pieceOf(color));
+    key ^= Zobrist::key(pieceOf(color), idx);
+}
+
+void ThreatSolver::lift(int idx, int color)
+{
+    bb.remove(toX(idx), toY(idx));
+    key ^= Zobrist::key(pieceOf(color), idx);
+}
+
+bool ThreatSolver::attack(int depth, int *winMove)
+{
+    if (tick() || depth <= 0)
+        return false;
+
+    uint64_t k = cacheKey();
+    CacheEntry &slot = cache[k & cacheMask];
+    ++cacheProbes;
+    if (slot.key == k && (slot.win || slot.depth >= depth))
+    {
+        ++cacheHits;
+        if (slot.win && winMove)
+            *winMove = slot.move;
+        return slot.win;
+    }
+
+    auto prove = [&](int move)
+    {
+        slot = {k, static_cast<int16_t>(move), static_cast<int8_t>(depth), true};
+        if (winMove)
+            *winMove = move;
+        return true;
+    };
+
+    // 1. 攻方可直接成五
+    BitPlane fives = Threats::windowCells(bb, att, 4);
+    if (fives.any())
+    {
+        int move = -1;
+        fives.forEach([&](int idx)
+                      { if (move < 0) move = idx; });
+        return prove(move);
+    }
+
+    // 2. 守方已有成五点：攻方必须先防守，强制序列不成立
+    if (Threats::windowCells(bb, def, 4).any())
+        return false;
+
+    // 3. 冲四：守方只能挡在成五点上
+    BitPlane fours = Threats::windowCells(bb, att, 3);
+    bool found = false;
+    int winning = -1;
+    fours.forEach([&](int idx)
+                  {
+        if (found || exhausted())
+            return;
+        place(idx, att);
+        int block = -1;
+        int count = Threats::fiveCompletions(bb, att, idx, block);
+        bool ok = false;
+        if (count >= 2)
+        {
+            ok = true; // 活四（或双四），守方挡不住
+        }
+        else if (count == 1)
+        {
+            place(block, def);
+            ok = attack(depth - 1, nullptr);
+            lift(block, def);
+        }
+        lift(idx, att);
+        if (ok)
+        {
+            found = true;
+            winning = idx;
+        } });
+    if (found)
+        return prove(winning);
+
+    // 4. 活三（仅 VCT）：守方须逐一尝试所有防守手段
+    if (mode == Mode::VCT)
+    {
+        BitPlane threes = Threats::windowCells(bb, att, 2).andNot(fours);
+        threes.forEach([&](int idx)
+                       {
+            if (found || exhausted())
+                return;
+            place(idx, att);
+            bool ok = Threats::threatCells(bb, att, idx).any() && defend(depth, idx);
+            lift(idx, att);
+            if (ok)
+            {
+                found = true;
+                winning = idx;
+            } });
+        if (found)
+            return prove(winning);
+    }
+
+    // 节点预算耗尽或被中止时的失败不是真正的证伪，不写缓存
+    if (!exhausted())
+        slot = {k, -1, static_cast<int8_t>(depth), false};
+    return false;
+}
+
+bool ThreatSolver::defend(int depth, int threatIdx)
+{
+    if (tick())
+        return false;
+
+    // 守方可直接成五
+    if (Threats::windowCells(bb, def, 4).any())
+        return false;
+
+    // 威胁已经不存在（被守方冲四时顺带挡住），守方获得先手
+    if (!Threats::threatCells(bb, att, threatIdx).any())
+        return false;
+
+    // 普通防守：过威胁点四线上、距离 5 以内能消除全部威胁的空位
+    const BoardGeometry &geo = bb.geometry();
+    BitPlane tried;
+    for (int d = 0; d < DIRS; ++d)
+    {
+        int l = geo.line[d][threatIdx];
+        int b = geo.pos[d][threatIdx] + LINE_PAD;
+        uint32_t empty = geo.lineMask[d][l] & ~(bb.lineWord(0, d, l) | bb.lineWord(1, d, l));
+        uint32_t range = (b >= 5 ? (0x7FFu << (b - 5)) : (0x7FFu >> (5 - b)));
+        for (uint32_t bits = empty & range; bits; bits &= bits - 1)
+        {
+            int idx = geo.cell[d][l][__builtin_ctz(bits) - LINE_PAD];
+            if (tried.test(idx))
+                continue;
+            tried.set(idx);
+
+            place(idx, def);
+            bool refuted = false;
+            if (!Threats::threatCells(bb, att, threatIdx).any())
+                refuted = !attack(depth - 1, nullptr);
+            lift(idx, def);
+            if (refuted)
+                return false;
+        }
+    }
+
+    // 反击：守方冲四，攻方被迫挡住后守方仍需面对原威胁
+    bool refuted = false;
+    Threats::windowCells(bb, def, 3).forEach([&](int idx)
+                                {
+        if (refuted || exhausted())
+            return;
+        place(idx, def);
+        int block = -1;
+        int count = Threats::fiveCompletions(bb, def, idx, block);
+        if (count >= 2)
+        {
+            refuted = true; // 守方活四
+        }
+        else if (count == 1)
+        {
+            place(block, att);
+            // 攻方挡的这一手若顺势成五，攻方胜
+            bool attackerFive = bb.isFive(toX(block), toY(block), pieceOf(att));
+            refuted = !attackerFive && !defend(depth, threatIdx);
+            lift(block, att);
+        }
+        lift(idx, def); });
+
+    return !refuted && !exhausted();
+}
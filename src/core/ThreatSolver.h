@@ -0,0 +1,85 @@
+#ifndef THREATSOLVER_H
+#define THREATSOLVER_H
+
+#include "Bitboard.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 威胁空间搜索（VCF / VCT）
+ *
+ * 只搜索攻方的强制着法：
+ *   - VCF（连续冲四胜）：攻方每步都冲四，守方只能挡在唯一的成五点上；
+ *   - VCT（连续活三胜）：攻方还可以走活三，守方的应手为所有能消除该威胁的点以及守方自己的冲四。
+ * 着法生成直接在线位串上按 5 格窗口枚举，不做全盘评估；已证明/已证伪的局面记入证明缓存，
+ * 证伪结果同时记下搜索深度，只在不更深的搜索里复用。
+ * 判定偏保守：守方一旦先有冲四，或出现无法精确处理的反击，按“未能证明”处理，不会误报胜利。
+ */
+class ThreatSolver
+{
+public:
+    enum class Mode : uint8_t
+    {
+        VCF,
+        VCT
+    };
+
+    struct Result
+    {
+        bool win = false;
+        int x = -1, y = -1;  // 攻方第一手
+        int depth = 0;       // 证明所需的攻方步数
+        uint64_t nodes = 0;
+        uint64_t cacheProbes = 0; // 证明缓存查询次数
+        uint64_t cacheHits = 0;   // 其中可直接复用的次数
+    };
+
+    explicit ThreatSolver(int cacheBits = 16);
+
+    void setNodeLimit(uint64_t limit) { nodeLimit = limit; }
+    // 外部中止标志（可为空）与截止时刻（GetTimeMS 时基，0 为不限），每 STOP_CHECK_INTERVAL 个节点检查一次；
+    // 触发后与节点预算耗尽同样处理：尽快返回“未能证明”，不写证伪缓存
+    void setStopFlag(const std::atomic<bool> *flag) { stopFlag = flag; }
+    void setDeadline(uint64_t timeMs) { deadline = timeMs; }
+
+    // 在 board 上为 attacker 寻找不超过 maxDepth 步攻方着法的强制胜
+    Result solve(const Bitboard &board, Piece attacker, Mode mode, int maxDepth);
+
+private:
+    static constexpr uint64_t STOP_CHECK_INTERVAL = 256;
+
+    struct CacheEntry
+    {
+        uint64_t key = 0;
+        int16_t move = -1;
+        int8_t depth = 0; // 证伪时的搜索深度
+        bool win = false;
+    };
+
+    bool attack(int depth, int *winMove);
+    bool defend(int depth, int threatIdx);
+
+    void place(int idx, int color);
+    void lift(int idx, int color);
+
+    uint64_t cacheKey() const;
+    bool tick(); // 计入一个节点，返回是否应当停止
+    bool exhausted() const { return stopped || nodes > nodeLimit; }
+
+    Bitboard bb;
+    uint64_t key = 0;
+    int att = 0, def = 1;
+    Mode mode = Mode::VCF;
+    uint64_t nodes = 0;
+    uint64_t cacheProbes = 0;
+    uint64_t cacheHits = 0;
+    uint64_t nodeLimit = 200000;
+    const std::atomic<bool> *stopFlag = nullptr;
+    uint64_t deadline = 0;
+    bool stopped = false;
+    std::vector<CacheEntry> cache;
+    uint64_t cacheMask;
+};
+
+#endif // THREATSOLVER_H
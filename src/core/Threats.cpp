@@ -0,0 +1,150 @@
+#include "Threats.h"
+#include <algorithm>
+
+using namespace BoardBits;
+
+namespace
+{
+    constexpr int MAX_WINDOW_START = 27; // 线位串最多 32 位，5 格窗口起点上限
+}
+
+namespace Threats
+{
+    uint32_t fiveCells(uint32_t own, uint32_t empty, int lo, int hi)
+    {
+        uint32_t r = 0;
+        for (int s = std::max(lo, 0); s <= std::min(hi, MAX_WINDOW_START); ++s)
+        {
+            uint32_t miss = (0x1Fu << s) & ~own;
+            if (miss && !(miss & (miss - 1)) && (miss & empty))
+                r |= miss;
+        }
+        return r;
+    }
+
+    bool hasFive(uint32_t own, int lo, int hi)
+    {
+        int from = std::max(lo, 0), to = std::min(hi, MAX_WINDOW_START);
+        if (from > to)
+            return false;
+        uint32_t starts = (0xFFFFFFFFu >> (31 - to)) & (0xFFFFFFFFu << from);
+        return (WinDetector::fiveStarts(own) & starts) != 0;
+    }
+
+    BitPlane windowCells(const Bitboard &board, int color, int need)
+    {
+        const BoardGeometry &geo = board.geometry();
+        BitPlane result;
+        for (int d = 0; d < DIRS; ++d)
+        {
+            for (int l = 0; l < geo.lineCount[d]; ++l)
+            {
+                uint32_t own = board.lineWord(color, d, l);
+                if (__builtin_popcount(own) < need)
+                    continue;
+                uint32_t empty = geo.lineMask[d][l] & ~(own | board.lineWord(color ^ 1, d, l));
+                for (int s = 0; s <= MAX_WINDOW_START; ++s)
+                {
+                    uint32_t m = 0x1Fu << s;
+                    if ((m & ~(own | empty)) != 0 || __builtin_popcount(own & m) != need)
+                        continue;
+                    for (uint32_t bits = m & empty; bits; bits &= bits - 1)
+                        result.set(geo.cell[d][l][__builtin_ctz(bits) - LINE_PAD]);
+                }
+            }
+        }
+        return result;
+    }
+
+    BitPlane fivePoints(const Bitboard &board, int color)
+    {
+        const BoardGeometry &geo = board.geometry();
+        BitPlane result;
+        for (int d = 0; d < DIRS; ++d)
+        {
+            for (int l = 0; l < geo.lineCount[d]; ++l)
+            {
+                uint32_t own = board.lineWord(color, d, l);
+                if (__builtin_popcount(own) < 4)
+                    continue;
+                uint32_t empty = geo.lineMask[d][l] & ~(own | board.lineWord(color ^ 1, d, l));
+                // 空位在窗口第 k 格：其余四格为己方的窗口起点，再移回空位所在的位
+                uint32_t shifted[5];
+                for (int j = 0; j < 5; ++j)
+                    shifted[j] = own >> j;
+                uint32_t cells = 0;
+                for (int k = 0; k < 5; ++k)
+                {
+                    uint32_t starts = empty >> k;
+                    for (int j = 0; j < 5; ++j)
+                        starts &= j == k ? ~0u : shifted[j];
+                    cells |= starts << k;
+                }
+                for (; cells; cells &= cells - 1)
+                    result.set(geo.cell[d][l][__builtin_ctz(cells) - LINE_PAD]);
+            }
+        }
+        return result;
+    }
+
+    int fiveCompletions(const Bitboard &board, int color, int idx, int &cell)
+    {
+        const BoardGeometry &geo = board.geometry();
+        int count = 0;
+        for (int d = 0; d < DIRS; ++d)
+        {
+            int l = geo.line[d][idx];
+            int b = geo.pos[d][idx] + LINE_PAD;
+            uint32_t own = board.lineWord(color, d, l);
+            uint32_t empty = geo.lineMask[d][l] & ~(own | board.lineWord(color ^ 1, d, l));
+            uint32_t cells = fiveCells(own, empty, b - 4, b);
+            if (cells)
+            {
+                count += __builtin_popcount(cells);
+                cell = geo.cell[d][l][__builtin_ctz(cells) - LINE_PAD];
+            }
+        }
+        return count;
+    }
+
+    BitPlane threatCells(const Bitboard &board, int color, int idx)
+    {
+        const BoardGeometry &geo = board.geometry();
+        BitPlane result;
+        for (int d = 0; d < DIRS; ++d)
+        {
+            int l = geo.line[d][idx];
+            int b = geo.pos[d][idx] + LINE_PAD;
+            uint32_t own = board.lineWord(color, d, l);
+            uint32_t empty = geo.lineMask[d][l] & ~(own | board.lineWord(color ^ 1, d, l));
+            uint32_t range = (0x1FFu << b) >> 4; // b-4 .. b+4
+            for (uint32_t bits = empty & range; bits; bits &= bits - 1)
+            {
+                int c = __builtin_ctz(bits);
+                uint32_t own2 = own | (1u << c);
+                uint32_t empty2 = empty & ~(1u << c);
+                int lo = std::max(b, c) - 4;
+                int hi = std::min(b, c);
+                // 该点落子后成五，或形成两个成五点（活四）
+                if (hasFive(own2, lo, hi) || __builtin_popcount(fiveCells(own2, empty2, lo, hi)) >= 2)
+                    result.set(geo.cell[d][l][c - LINE_PAD]);
+            }
+        }
+        return result;
+    }
+
+    bool makesLiveFour(const Bitboard &board, int color, int idx)
+    {
+        const BoardGeometry &geo = board.geometry();
+        for (int d = 0; d < DIRS; ++d)
+        {
+            int l = geo.line[d][idx];
+            int b = geo.pos[d][idx] + LINE_PAD;
+            uint32_t own = board.lineWord(color, d, l) | (1u << b);
+            uint32_t empty = geo.lineMask[d][l] & ~(own | board.lineWord(color ^ 1, d, l));
+            if (hasFive(own, b - 4, b) || __builtin_popcount(fiveCells(own, empty, b - 4, b)) >= 2)
+                return true;
+        }
+        return false;
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef THREATS_H
+#define THREATS_H
+
+#include "Bitboard.h"
+#include <cstdint>
+
+/**
+ * @brief 基于线位串的威胁识别
+ *
+ * 供 VCF/VCT 搜索与证明数搜索共用。线位串中位 pos + LINE_PAD 对应线上位置 pos，
+ * 5 格窗口的起点即窗口最低位的位号。
+ */
+namespace Threats
+{
+    // 起点在 [lo, hi] 内的 5 格窗口中，只差一子成五且该点为空的位置
+    uint32_t fiveCells(uint32_t own, uint32_t empty, int lo, int hi);
+
+    // 起点在 [lo, hi] 内的 5 格窗口中是否已有五连
+    bool hasFive(uint32_t own, int lo, int hi);
+
+    // color 方所有“5 格窗口内恰有 need 子且其余为空”的窗口中的空位
+    // need = 4 为成五点，need = 3 为冲四点，need = 2 为可形成活三/眠三的点
+    BitPlane windowCells(const Bitboard &board, int color, int need);
+
+    // color 方全部成五点，与 windowCells(board, color, 4) 相同，按线移位相与求出，供着法排序逐节点调用
+    BitPlane fivePoints(const Bitboard &board, int color);
+
+    // color 方在过 idx 的四线上、覆盖 idx 的成五点数目（cell 返回其中一个）
+    int fiveCompletions(const Bitboard &board, int color, int idx, int &cell);
+
+    // color 方在过 idx 的四线上能形成活四或五连的空位（即 idx 所在活三的威胁点）
+    BitPlane threatCells(const Bitboard &board, int color, int idx);
+
+    // color 方在空位 idx 落子后，过 idx 的某条线上是否成五或形成活四（两个以上成五点）
+    bool makesLiveFour(const Bitboard &board, int color, int idx);
+}
+
+#endif // THREATS_H
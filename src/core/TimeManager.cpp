@@ -0,0 +1,53 @@
+#include "TimeManager.h"
+#include "Timer.hpp"
+#include <algorithm>
+
+TimeManager::TimeManager(int clockMs, int incrementMs)
+    : clockMs(clockMs), incrementMs(incrementMs) {}
+
+void TimeManager::setClock(int remainingMs, int incrementMs)
+{
+    clockMs = std::max(0, remainingMs);
+    this->incrementMs = std::max(0, incrementMs);
+}
+
+void TimeManager::start(const SearchLimits &limits, int ply)
+{
+    startMs = GetTimeMS();
+
+    if (limits.timeMs > 0)
+    {
+        // 固定每步用时：过半后不再开始新一轮迭代
+        hardMs = limits.timeMs;
+        softMs = limits.timeMs / 2;
+        return;
+    }
+
+    // 预留一部分时间应对调度与通信延迟
+    int reserve = std::min(1000, clockMs / 10);
+    int available = std::max(0, clockMs - reserve);
+
+    // 五子棋一方通常 20~40 手内结束，越往后剩余手数估计越少
+    int movesToGo = std::max(10, 35 - ply / 2);
+    softMs = available / movesToGo + incrementMs * 3 / 4;
+    hardMs = std::min(softMs * 3, available / 3 + incrementMs);
+
+    softMs = std::min(softMs, maxMoveMs);
+    hardMs = std::min(hardMs, maxMoveMs);
+    softMs = std::min(softMs, hardMs);
+}
+
+void TimeManager::finish()
+{
+    clockMs = std::max(0, clockMs - elapsed()) + incrementMs;
+}
+
+uint64_t TimeManager::deadline(int ms) const
+{
+    return startMs + static_cast<uint64_t>(std::max(0, std::min(ms, hardMs)));
+}
+
+int TimeManager::elapsed() const
+{
+    return static_cast<int>(GetTimeMS() - startMs);
+}
@@ -0,0 +1,49 @@
+#ifndef TIMEMANAGER_H
+#define TIMEMANAGER_H
+
+#include "GameConfig.h"
+#include "SearchTypes.h"
+#include <cstdint>
+
+/**
+ * @brief AI 用时管理
+ *
+ * 跟踪 AI 自己的棋钟（默认 DEFAULT_GAME_TIME_MINUTES 分钟 + 每步 DEFAULT_INCREMENT_SECONDS 秒加秒），
+ * 每步开始时分配两条期限：
+ *   - soft：超过后不再开始新一轮迭代；
+ *   - hard：搜索中途到达即中止，保证不会超时。
+ * 外部可随时用 setClock 同步真实棋钟；未同步时按每步实际用时自行扣减并加秒。
+ */
+class TimeManager
+{
+public:
+    TimeManager(int clockMs = GameConfig::DEFAULT_GAME_TIME_MINUTES * 60 * 1000,
+                int incrementMs = GameConfig::DEFAULT_INCREMENT_SECONDS * 1000);
+
+    void setClock(int remainingMs, int incrementMs);
+    void setMaxMoveTime(int ms) { maxMoveMs = ms; }
+    int remaining() const { return clockMs; }
+
+    // 开始一步的思考，ply 为当前棋盘上的棋子数
+    void start(const SearchLimits &limits, int ply);
+    // 结束一步的思考，扣除用时并加秒
+    void finish();
+
+    int elapsed() const;
+    bool softExpired() const { return elapsed() >= softMs; }
+    bool hardExpired() const { return elapsed() >= hardMs; }
+    int softLimit() const { return softMs; }
+    int hardLimit() const { return hardMs; }
+    // 本步开始后 ms 毫秒对应的时刻（GetTimeMS 时基），不晚于 hard 期限；供自行计时的求解器使用
+    uint64_t deadline(int ms) const;
+
+private:
+    int clockMs;
+    int incrementMs;
+    int maxMoveMs = GameConfig::DEFAULT_AI_MAX_MOVE_MS;
+    uint64_t startMs = 0;
+    int softMs = 0;
+    int hardMs = 0;
+};
+
+#endif // TIMEMANAGER_H
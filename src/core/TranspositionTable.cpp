@@ -0,0 +1,127 @@
+#include "TranspositionTable.h"
+#include <algorithm>
+
+TranspositionTable::TranspositionTable(size_t megabytes)
+{
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes)
+{
+    size_t bytes = std::max<size_t>(megabytes, 1) * 1024 * 1024;
+    size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= bytes)
+        count *= 2;
+
+    buckets.reset(new Bucket[count]);
+    bucketCount = count;
+    mask = count - 1;
+    generation = 0;
+}
+
+void TranspositionTable::clear()
+{
+    for (size_t i = 0; i < bucketCount; ++i)
+    {
+        for (Slot &s : buckets[i].slots)
+        {
+            s.check.store(0, std::memory_order_relaxed);
+            s.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+// data 布局：score(32) | move(16) | depth(8) | genBound(8)
+uint64_t TranspositionTable::pack(const Entry &e)
+{
+    return uint64_t(uint32_t(e.score)) |
+           uint64_t(uint16_t(e.move)) << 32 |
+           uint64_t(uint8_t(e.depth)) << 48 |
+           uint64_t(e.genBound) << 56;
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(uint64_t key, uint64_t data)
+{
+    Entry e;
+    e.key = key;
+    e.score = static_cast<int32_t>(uint32_t(data));
+    e.move = static_cast<int16_t>(uint16_t(data >> 32));
+    e.depth = static_cast<int8_t>(uint8_t(data >> 48));
+    e.genBound = static_cast<uint8_t>(data >> 56);
+    return e;
+}
+
+bool TranspositionTable::probe(uint64_t key, Entry &out) const
+{
+    Bucket &b = bucketFor(key);
+    for (Slot &s : b.slots)
+    {
+        uint64_t data = s.data.load(std::memory_order_relaxed);
+        uint64_t check = s.check.load(std::memory_order_relaxed);
+        if ((check ^ data) == key && data != 0)
+        {
+            out = unpack(key, data);
+            if (out.bound() != Bound::None)
+                return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, int depth, Bound bound, int score, int move)
+{
+    Bucket &b = bucketFor(key);
+    Slot *victim = nullptr;
+    Entry old;
+    int worst = 0;
+    for (Slot &s : b.slots)
+    {
+        uint64_t data = s.data.load(std::memory_order_relaxed);
+        uint64_t slotKey = s.check.load(std::memory_order_relaxed) ^ data;
+        Entry e = unpack(slotKey, data);
+        if (slotKey == key || e.bound() == Bound::None)
+        {
+            victim = &s;
+            old = e;
+            break;
+        }
+        int age = (generation - e.generation()) & 0x3F;
+        int value = e.depth - 8 * age;
+        if (!victim || value < worst)
+        {
+            victim = &s;
+            old = e;
+            worst = value;
+        }
+    }
+
+    // 同一局面的新结果没有最佳着法时，保留旧的最佳着法用于排序
+    if (move < 0 && old.key == key)
+        move = old.move;
+
+    Entry e;
+    e.score = score;
+    e.move = static_cast<int16_t>(move);
+    e.depth = static_cast<int8_t>(depth);
+    e.genBound = static_cast<uint8_t>((generation << 2) | static_cast<uint8_t>(bound));
+    uint64_t data = pack(e);
+    victim->data.store(data, std::memory_order_relaxed);
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const
+{
+    const size_t samples = std::min<size_t>(bucketCount, 250);
+    int used = 0;
+    for (size_t i = 0; i < samples; ++i)
+    {
+        for (const Slot &s : buckets[i].slots)
+        {
+            Entry e = unpack(0, s.data.load(std::memory_order_relaxed));
+            if (e.bound() != Bound::None && e.generation() == generation)
+                ++used;
+        }
+    }
+    return samples ? static_cast<int>(used * 1000 / (samples * BUCKET_ENTRIES)) : 0;
+}
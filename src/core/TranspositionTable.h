@@ -0,0 +1,86 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief 置换表
+ *
+ * 固定大小、按缓存行（64 字节）对齐的桶数组，每桶 4 个 16 字节表项。
+ * 替换策略：同键直接覆盖；否则在桶内淘汰“深度 - 8 × 代差”最小的表项，
+ * 即优先淘汰旧搜索留下的和浅层的结果。
+ *
+ * 多线程搜索共享同一张表且不加锁：每个表项由两个原子 64 位字组成，
+ * 分别存 key ^ data 与 data，读取时两者异或还原出的键不符即视为未命中，
+ * 因此并发写造成的撕裂表项会被自动丢弃。
+ */
+class TranspositionTable
+{
+public:
+    enum class Bound : uint8_t
+    {
+        None,
+        Exact,
+        Lower, // 分数 >= score（fail-high）
+        Upper  // 分数 <= score（fail-low）
+    };
+
+    struct Entry
+    {
+        uint64_t key = 0;
+        int32_t score = 0;
+        int16_t move = -1; // 位平面索引，-1 表示无
+        int8_t depth = 0;
+        uint8_t genBound = 0; // 高 6 位为代数，低 2 位为 Bound
+
+        Bound bound() const { return static_cast<Bound>(genBound & 3); }
+        uint8_t generation() const { return genBound >> 2; }
+    };
+
+    static constexpr int BUCKET_ENTRIES = 4;
+
+    explicit TranspositionTable(size_t megabytes = 16);
+
+    // 重新分配表（内容清空），实际桶数取不超过给定容量的 2 的幂；不可与搜索并发调用
+    void resize(size_t megabytes);
+    void clear();
+
+    // 每次新的根搜索前调用，推进代数
+    void newSearch() { generation = (generation + 1) & 0x3F; }
+
+    // 命中时返回 true 并拷贝表项
+    bool probe(uint64_t key, Entry &out) const;
+    void store(uint64_t key, int depth, Bound bound, int score, int move);
+
+    size_t sizeMB() const { return bucketCount * sizeof(Bucket) / (1024 * 1024); }
+
+    // 抽样估计表的占用率（千分比）
+    int hashfull() const;
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> check{0}; // key ^ data
+        std::atomic<uint64_t> data{0};
+    };
+
+    struct alignas(64) Bucket
+    {
+        Slot slots[BUCKET_ENTRIES];
+    };
+
+    static uint64_t pack(const Entry &e);
+    static Entry unpack(uint64_t key, uint64_t data);
+
+    Bucket &bucketFor(uint64_t key) const { return buckets[key & mask]; }
+
+    std::unique_ptr<Bucket[]> buckets;
+    size_t bucketCount = 0;
+    uint64_t mask = 0;
+    uint8_t generation = 0;
+};
+
+#endif // TRANSPOSITIONTABLE_H
@@ -0,0 +1,104 @@
+#ifndef WINDETECTOR_H
+#define WINDETECTOR_H
+
+#include "GameConfig.h"
+#include <cstdint>
+
+/**
+ * @brief 连五判定（Game 与 AI 共用）
+ *
+ * 以一条线上某方棋子的位串为输入，移位相与得到所有五连起点，再与“覆盖落子点”的
+ * 起点范围相与，没有逐格循环与分支。Rule::Exact 为恰好五连（长连不算胜）的规则变体。
+ */
+namespace WinDetector
+{
+    enum class Rule : uint8_t
+    {
+        Freestyle, // 五连及以上获胜
+        Exact      // 只有恰好五连获胜，长连不算
+    };
+
+    constexpr int DIRS = 4;
+    constexpr int MAX_LINES = 2 * GameConfig::MAX_BOARD_SIZE - 1;
+
+    // 位串中所有五连的起点（位 s 置位表示 s .. s+4 全为己方）
+    inline uint32_t fiveStarts(uint32_t line)
+    {
+        return line & (line >> 1) & (line >> 2) & (line >> 3) & (line >> 4);
+    }
+
+    // 覆盖位 bit 的五连起点只能在 [bit-4, bit] 内
+    inline uint32_t coverMask(int bit) { return (0x1Fu << bit) >> 4; }
+
+    // 是否存在覆盖位 bit 的五连（bit 不超过 27）
+    inline bool fiveThrough(uint32_t line, int bit, Rule rule = Rule::Freestyle)
+    {
+        uint32_t starts = fiveStarts(line);
+        if (rule == Rule::Exact)
+            starts &= ~(line << 1) & ~(line >> 5); // 两端外侧都不是己方棋子
+        return (starts & coverMask(bit)) != 0;
+    }
+
+    // 是否存在覆盖位 bit 的长连（六子及以上）
+    inline bool overlineThrough(uint32_t line, int bit)
+    {
+        uint32_t six = fiveStarts(line) & (line >> 5);
+        return (six & ((0x3Fu << bit) >> 5)) != 0;
+    }
+
+    /**
+     * @brief 按四个方向维护的线位串，供没有 Bitboard 的一方（如 Game）增量维护
+     *
+     * 方向顺序与 BoardBits 一致：垂直、水平、主对角线、副对角线。
+     * 线编号依次为 y、x、x - y + MAX - 1、x + y；线上位置水平方向取 y，其余取 x。
+     */
+    class LineMasks
+    {
+    public:
+        void clear()
+        {
+            for (auto &color : words)
+                for (auto &dir : color)
+                    for (uint32_t &w : dir)
+                        w = 0;
+        }
+
+        void set(int x, int y, int color)
+        {
+            for (int d = 0; d < DIRS; ++d)
+                words[color][d][lineOf(d, x, y)] |= 1u << posOf(d, x, y);
+        }
+
+        void reset(int x, int y, int color)
+        {
+            for (int d = 0; d < DIRS; ++d)
+                words[color][d][lineOf(d, x, y)] &= ~(1u << posOf(d, x, y));
+        }
+
+        // color 方过 (x, y) 是否成五
+        bool isFive(int x, int y, int color, Rule rule = Rule::Freestyle) const
+        {
+            bool five = false;
+            for (int d = 0; d < DIRS; ++d)
+                five |= fiveThrough(words[color][d][lineOf(d, x, y)], posOf(d, x, y), rule);
+            return five;
+        }
+
+    private:
+        static int lineOf(int d, int x, int y)
+        {
+            switch (d)
+            {
+            case 0: return y;
+            case 1: return x;
+            case 2: return x - y + GameConfig::MAX_BOARD_SIZE - 1;
+            default: return x + y;
+            }
+        }
+        static int posOf(int d, int x, int y) { return d == 1 ? y : x; }
+
+        uint32_t words[2][DIRS][MAX_LINES] = {};
+    };
+}
+
+#endif // WINDETECTOR_H
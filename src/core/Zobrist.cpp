@@ -0,0 +1,35 @@
+#include "Zobrist.h"
+#include <array>
+
+namespace
+{
+    // splitmix64：简单、可复现的 64 位随机数发生器
+    uint64_t splitmix64(uint64_t &state)
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    using KeyTable = std::array<std::array<uint64_t, BoardBits::CELLS>, 2>;
+
+    const KeyTable &keys()
+    {
+        static const KeyTable table = []
+        {
+            KeyTable t{};
+            uint64_t state = 0x5A0B21C4D3E2F1ULL;
+            for (auto &color : t)
+                for (auto &k : color)
+                    k = splitmix64(state);
+            return t;
+        }();
+        return table;
+    }
+}
+
+uint64_t Zobrist::key(Piece p, int idx)
+{
+    return keys()[BoardBits::colorIndex(p)][idx];
+}
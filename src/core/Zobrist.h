@@ -0,0 +1,18 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "Bitboard.h"
+#include <cstdint>
+
+/**
+ * @brief Zobrist 随机键
+ *
+ * 每种颜色、每个位平面索引一个 64 位随机数，由固定种子生成，保证不同进程间键值一致
+ *（开局库等持久化数据依赖这一点）。局面键为所有棋子对应随机数的异或。
+ */
+namespace Zobrist
+{
+    uint64_t key(Piece p, int idx);
+}
+
+#endif // ZOBRIST_H
@@ -22,14 +22,19 @@ RoomWidget::RoomWidget(QWidget *parent)
       isWhiteTaken(false),
       isBlackAI(false),
       isWhiteAI(false),
-      blackAI(std::make_unique<AiPlayer>(Piece::BLACK)),
-      whiteAI(std::make_unique<AiPlayer>(Piece::WHITE))
+      blackAI(AiEngine::create(AiEngine::Kind::AlphaBeta, Piece::BLACK)),
+      whiteAI(AiEngine::create(AiEngine::Kind::AlphaBeta, Piece::WHITE)),
+      aiService(std::make_unique<AiService>())
 {
     ui->setupUi(this);
+    connect(aiService.get(), &AiService::moveReady, this, &RoomWidget::onAIMoveReady);
     initComponents();
 }
 
-RoomWidget::~RoomWidget() {}
+RoomWidget::~RoomWidget()
+{
+    cancelAI();
+}
 
 void RoomWidget::initComponents()
 {
@@ -43,6 +48,7 @@ void RoomWidget::initComponents()
 
 void RoomWidget::reset(bool localMode)
 {
+    cancelAI();
     isLocal = localMode;
     game->setLocalMode(isLocal);
     game->reset();
@@ -59,20 +65,24 @@ void RoomWidget::reset(bool localMode)
 
     ui->addAIBlackButton->setVisible(isLocal);
     ui->addAIWhiteButton->setVisible(isLocal);
+    ui->aiEngineCombo->setVisible(isLocal);
     update();
 }
 
 void RoomWidget::connectComponentSignals()
 {
     // Game 核心回调
-    game->setOnBoardChanged([this](const auto &)
-                            { update(); });
+    game->setOnBoardChange([this](const BoardChange &change)
+                           { updateChessBoardCell(change); });
+    game->setOnBoardChangeBatch([this](const std::vector<BoardChange> &)
+                                { updateChessBoardDisplay(); });
     game->setOnTurnChanged([this](Piece p)
                            { checkAndExecuteAI(p); });
     game->setOnGameStarted([this]
                            { SwitchGameStatus(GameStatus::Playing); });
     game->setOnGameEnded([this](const std::string &msg)
                          {
+        cancelAI();
         paintGameOver(QString::fromStdString(msg));
         SwitchGameStatus(GameStatus::End); });
 
@@ -81,7 +91,10 @@ void RoomWidget::connectComponentSignals()
         if (!isLocal) emit makeMove(x, y); });
 
     // 基础 UI 信号
-    connect(ui->backToLobbyButton, &QPushButton::clicked, this, &RoomWidget::backToLobby);
+    connect(ui->backToLobbyButton, &QPushButton::clicked, this, [this]
+            {
+        cancelAI();
+        emit backToLobby(); });
     connect(ui->sendButton, &QPushButton::clicked, this, [this]()
             {
         QString msg = ui->messageInput->text();
@@ -135,15 +148,18 @@ void RoomWidget::SetUpPlayerInfoPanel()
             { handleAI(true); });
     connect(ui->addAIWhiteButton, &QPushButton::clicked, this, [=]
             { handleAI(false); });
+    // 下拉框的顺序与 AiEngine::Kind 一致
+    connect(ui->aiEngineCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this](int index)
+            { setAIEngine(index == 1 ? AiEngine::Kind::Mcts : AiEngine::Kind::AlphaBeta); });
 
     // 取消座位
     connect(ui->cancelBlackButton, &QPushButton::clicked, this, [this]
             {
-        if (isLocal) { isBlackTaken = false; SwitchPlayerInfoPanal(true, false); ui->player1NameLabel->setText("等待玩家..."); }
+        if (isLocal) { if (isBlackAI) cancelAI(); isBlackTaken = isBlackAI = false; SwitchPlayerInfoPanal(true, false); ui->player1NameLabel->setText("等待玩家..."); }
         else emit SyncSeat("", ""); });
     connect(ui->cancelWhiteButton, &QPushButton::clicked, this, [this]
             {
-        if (isLocal) { isWhiteTaken = false; SwitchPlayerInfoPanal(false, false); ui->player2NameLabel->setText("等待玩家..."); }
+        if (isLocal) { if (isWhiteAI) cancelAI(); isWhiteTaken = isWhiteAI = false; SwitchPlayerInfoPanal(false, false); ui->player2NameLabel->setText("等待玩家..."); }
         else emit SyncSeat("", ""); });
 }
 
@@ -228,6 +244,7 @@ void RoomWidget::onUndoMove(NegStatus status)
         // 同意悔棋，调用Game的undo方法
         if (game)
         {
+            cancelAI();
             bool success = game->undo();
             if (success)
             {
@@ -268,8 +285,11 @@ void RoomWidget::onGameStarted()
     }
     if (gameStatus == End)
     {
+        cancelAI();
         game->reset();
     }
+    if (isLocal)
+        syncAIBoardSize();
     game->start();
     gameStatus = GameStatus::Playing;
     update();
@@ -333,7 +353,7 @@ void RoomWidget::paintGameOver(QString msg)
     const int pieceRadius = 18;
     const int boardMargin = 20;
     const int starPointRadius = 4;
-    const int boardSize = 15;
+    const int boardSize = game->getBoardView().size(); // 同步可能改变棋盘尺寸
 
     // 计算棋盘实际位置
     int boardLength = gridSize * (boardSize - 1);
@@ -370,6 +390,29 @@ void RoomWidget::updateChessBoardDisplay()
     }
 }
 
+void RoomWidget::updateChessBoardCell(const BoardChange &change)
+{
+    QWidget *chessBoardWidget = ui->chessBoardWidget;
+    if (!chessBoardWidget)
+        return;
+    if (change.kind == BoardChange::Kind::Reset)
+    {
+        chessBoardWidget->update();
+        return;
+    }
+
+    // 与 paintChessBoard 相同的几何参数；区域覆盖棋子及其阴影偏移
+    const int gridSize = 40;
+    const int pieceRadius = 18;
+    const int shadowOffset = 2;
+    int boardLength = gridSize * (game->getBoardView().size() - 1);
+    QPoint boardTopLeft((chessBoardWidget->width() - boardLength) / 2,
+                        (chessBoardWidget->height() - boardLength) / 2);
+    QPoint center(boardTopLeft.x() + change.x * gridSize, boardTopLeft.y() + change.y * gridSize);
+    int extent = pieceRadius + shadowOffset + 1;
+    chessBoardWidget->update(QRect(center.x() - extent, center.y() - extent, 2 * extent, 2 * extent));
+}
+
 bool RoomWidget::isPlaying()
 {
     // 检查游戏是否正在进行中
@@ -423,18 +466,64 @@ void RoomWidget::checkAndExecuteAI(Piece currPlayer)
                     (currPlayer == Piece::WHITE && isWhiteAI);
     if (isAiTurn && gameStatus == Playing)
     {
-        QTimer::singleShot(600, this, [this, currPlayer]()
+        quint64 ticket = aiTicket;
+        QTimer::singleShot(600, this, [this, currPlayer, ticket]()
                            {
-            // 再次确认状态，防止在延迟期间游戏结束或玩家退出
-            if (gameStatus != Playing) return;
+            // 再次确认状态，防止在延迟期间游戏结束、悔棋或玩家退出
+            if (gameStatus != Playing || ticket != aiTicket) return;
 
             auto* ai = (currPlayer == Piece::BLACK) ? blackAI.get() : whiteAI.get();
             if (ai) {
-                auto [x, y] = ai->getNextMove(game->getBoard());
-                game->move(x, y);
+                // 在工作线程上思考，结果由 onAIMoveReady 处理
+                aiRequestId = aiService->requestMove(ai, game->getBoardView());
             } });
     }
 }
+
+void RoomWidget::onAIMoveReady(quint64 requestId, int x, int y)
+{
+    // 只接受最近一次请求的结果
+    if (requestId != aiRequestId || gameStatus != Playing)
+        return;
+    aiRequestId = 0;
+    game->move(x, y);
+}
+
+void RoomWidget::setAIEngine(AiEngine::Kind kind)
+{
+    restartAIService();
+    blackAI = AiEngine::create(kind, Piece::BLACK);
+    whiteAI = AiEngine::create(kind, Piece::WHITE);
+    blackAI->setBoardSize(game->getBoardView().size());
+    whiteAI->setBoardSize(game->getBoardView().size());
+    // 若正轮到 AI，则用新引擎重新思考
+    if (gameStatus == Playing)
+        checkAndExecuteAI(game->getCurrentPlayer());
+}
+
+void RoomWidget::syncAIBoardSize()
+{
+    int boardSize = game->getBoardView().size();
+    restartAIService();
+    blackAI->setBoardSize(boardSize);
+    whiteAI->setBoardSize(boardSize);
+}
+
+void RoomWidget::restartAIService()
+{
+    cancelAI();
+    // 工作线程上可能还有刚被中止的搜索，须等它退出后才能修改或替换引擎
+    aiService = std::make_unique<AiService>();
+    connect(aiService.get(), &AiService::moveReady, this, &RoomWidget::onAIMoveReady);
+}
+
+void RoomWidget::cancelAI()
+{
+    ++aiTicket;
+    aiRequestId = 0;
+    aiService->cancel();
+}
+
 void RoomWidget::SetUpChessBoardWidget()
 {
     ui->chessBoardWidget->setMouseTracking(true);
@@ -475,7 +564,7 @@ bool RoomWidget::eventFilter(QObject *watched, QEvent *event)
         // 1. 处理绘图事件
         if (event->type() == QEvent::Paint)
         {
-            paintChessBoard(game->getBoard());
+            paintChessBoard(game->getBoardView());
             return true; // 告诉 Qt 该事件已处理，不要再画默认背景
         }
 
@@ -496,12 +585,11 @@ bool RoomWidget::eventFilter(QObject *watched, QEvent *event)
 
 // 绘图逻辑保持不变，但使用 member variable 替代 local 变量
 
-void RoomWidget::paintChessBoard(const std::vector<std::vector<Piece>> &board)
+void RoomWidget::paintChessBoard(const BoardView &board)
 
 {
     QWidget *chessBoardWidget = ui->chessBoardWidget;
     QPainter painter(chessBoardWidget);
-    chessBoardWidget->update();
     int boardSize = board.size();
     if (boardSize == 0)
         return;
@@ -559,7 +647,7 @@ void RoomWidget::paintChessBoard(const std::vector<std::vector<Piece>> &board)
     {
         for (int j = 0; j < boardSize; j++)
         {
-            if (board[i][j] != Piece::EMPTY)
+            if (board.at(i, j) != Piece::EMPTY)
             {
                 QPoint piecePos(boardTopLeft.x() + i * gridSize,
                                 boardTopLeft.y() + j * gridSize);
@@ -573,7 +661,7 @@ void RoomWidget::paintChessBoard(const std::vector<std::vector<Piece>> &board)
 
                 // 绘制棋子
                 QRadialGradient gradient(piecePos, pieceRadius);
-                if (board[i][j] == Piece::BLACK)
+                if (board.at(i, j) == Piece::BLACK)
 
                 {
 
@@ -622,6 +710,16 @@ void RoomWidget::onSyncGame(const QString &statusStr)
 {
     if (!statusStr.isEmpty() && game->sync(statusStr.toStdString()))
     {
+        cancelAI();
+        update();
+    }
+}
+
+void RoomWidget::onSyncGameRecord(const QByteArray &record)
+{
+    if (game->syncRecord(reinterpret_cast<const uint8_t *>(record.constData()), static_cast<size_t>(record.size())))
+    {
+        cancelAI();
         update();
     }
 }
@@ -629,7 +727,7 @@ void RoomWidget::onSyncGame(const QString &statusStr)
 QPoint RoomWidget::screenPosToGrid(const QPoint &pos, QWidget *boardWidget)
 {
     const int gridSize = 40;
-    const int boardSize = 15;
+    const int boardSize = game->getBoardView().size(); // 与绘制使用同一尺寸
     int boardLength = gridSize * (boardSize - 1);
     QPoint boardTopLeft((boardWidget->width() - boardLength) / 2, (boardWidget->height() - boardLength) / 2);
 
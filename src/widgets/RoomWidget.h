@@ -9,7 +9,8 @@
 #include <QMouseEvent>
 #include <memory>
 #include "Game.h"
-#include "AiPlayer.h"
+#include "AiEngine.h"
+#include "AiService.h"
 #include "Timer.hpp"
 #include "Packet.h"
 
@@ -76,6 +77,7 @@ public slots:
     void onDraw(NegStatus status);
     void onUndoMove(NegStatus status);
     void onSyncGame(const QString &str);
+    void onSyncGameRecord(const QByteArray &record);
 
 private slots:
     // ==================== Game核心回调处理 ====================
@@ -86,9 +88,10 @@ private:
     void SwitchPlayerInfoPanal(bool isBlack, bool isTaken);
     void SwitchGameStatus(GameStatus status);
 
-    void paintChessBoard(const std::vector<std::vector<Piece>> &board);
+    void paintChessBoard(const BoardView &board);
     void paintGameOver(const QString msg);
     void updateChessBoardDisplay();
+    void updateChessBoardCell(const BoardChange &change); // 只重绘变化的交叉点
     QPoint screenPosToGrid(const QPoint &pos, QWidget *boardWidget);
 
     void SetUpSignals();
@@ -104,6 +107,9 @@ private:
 public:
     QString username;
 
+    // 选择 AI 后端（Alpha-Beta / MCTS），会取消正在进行的思考
+    void setAIEngine(AiEngine::Kind kind);
+
 private:
     void SetUpConnections();
     void SetUpChessBoardWidget();
@@ -112,6 +118,13 @@ private:
     void SetUpFunctionalPanel();
 
     void checkAndExecuteAI(Piece currPlayer);
+    void onAIMoveReady(quint64 requestId, int x, int y);
+    // 作废所有在途的 AI 请求（包括尚在延迟中的）
+    void cancelAI();
+    // 等待工作线程退出并换上新的服务，之后才能安全地修改引擎
+    void restartAIService();
+    // 本地对局开始前让两个引擎采用对局的棋盘尺寸
+    void syncAIBoardSize();
     void handleBoardClick(int x, int y);
     bool eventFilter(QObject *watched, QEvent *event) override;
     void drawBoard(QPainter &painter); // 纯绘图，不触发 update
@@ -122,7 +135,11 @@ private:
     bool isLocal;
     bool isBlackTaken, isWhiteTaken;
     bool isBlackAI, isWhiteAI;
-    std::unique_ptr<AiPlayer> blackAI, whiteAI;
+    std::unique_ptr<AiEngine> blackAI, whiteAI;
+    // 须声明在 AI 引擎之后：析构时先停下工作线程，再销毁引擎
+    std::unique_ptr<AiService> aiService;
+    quint64 aiRequestId = 0; // 当前等待的 AI 请求编号
+    quint64 aiTicket = 0;    // 每次 cancelAI() 递增，使延迟中的请求失效
 };
 
 #endif // GAMEWIDGET_H
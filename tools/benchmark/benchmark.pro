@@ -0,0 +1,17 @@
+# 无界面的 AI 基准测试，只链接 src/core 中的引擎代码，不依赖 Qt
+TEMPLATE = app
+TARGET = gomoku-bench
+CONFIG += c++17 console
+CONFIG -= qt app_bundle
+
+include(../engine.pri)
+
+SOURCES += main.cpp
+
+# 默认局面集复制到输出目录，直接运行即可找到
+OTHER_FILES += positions.txt
+copy_corpus.commands = $(COPY_FILE) $$shell_path($$PWD/positions.txt) $$shell_path($$OUT_PWD)
+first.depends = $(first) copy_corpus
+export(first.depends)
+export(copy_corpus.commands)
+QMAKE_EXTRA_TARGETS += first copy_corpus
@@ -0,0 +1,275 @@
+// 无界面的 AI 基准测试：对固定局面集分别做定深与定时搜索，输出速度、到达深度的用时与解题数。
+// 用法：gomoku-bench [--corpus 文件] [--depth N] [--time 毫秒] [--threads N] [--kernel scalar|avx2] [--json 文件]
+// 人可读的逐局面结果写到 stderr，JSON 结果写到 stdout（或 --json 指定的文件），字段顺序固定，便于跨提交比较。
+
+#include "AiPlayer.h"
+#include "Game.h"
+#include "PatternBatch.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr int JSON_VERSION = 1;
+    constexpr int FIXED_DEPTH_TIME_MS = 10 * 60 * 1000; // 定深搜索的时间上限，只作兜底
+
+    struct BenchPosition
+    {
+        std::string category;
+        std::string name;
+        std::vector<std::pair<int, int>> accepted; // 为空表示不判定
+        Game game;
+    };
+
+    struct RunResult
+    {
+        std::pair<int, int> move = {-1, -1};
+        SearchStats stats;
+        std::vector<int> timeToDepth; // 第 i 项为完成第 i+1 轮迭代时的用时（毫秒）
+    };
+
+    struct Options
+    {
+        std::string corpus = "positions.txt";
+        std::string jsonPath;
+        int depth = 6;
+        int timeMs = 1000;
+        int threads = 1;
+        std::string kernel; // 为空时使用运行时检测到的内核
+    };
+
+    // 按 Game::serialize 的格式逐手重放，返回是否全部落子成功
+    bool replay(Game &game, const std::string &record)
+    {
+        size_t sep = record.find("||");
+        if (sep == std::string::npos)
+            return false;
+        game.reset();
+        game.start();
+        std::stringstream ss(record.substr(sep + 2));
+        std::string item;
+        while (std::getline(ss, item, ';'))
+        {
+            int p, x, y;
+            char c1, c2;
+            std::istringstream is(item);
+            if (!(is >> p >> c1 >> x >> c2 >> y) || !game.move(x, y))
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<std::pair<int, int>> parseAccepted(const std::string &text)
+    {
+        std::vector<std::pair<int, int>> moves;
+        if (text == "-")
+            return moves;
+        std::stringstream ss(text);
+        std::string item;
+        while (std::getline(ss, item, '|'))
+        {
+            int x, y;
+            char c;
+            std::istringstream is(item);
+            if (is >> x >> c >> y && c == ',')
+                moves.push_back({x, y});
+        }
+        return moves;
+    }
+
+    bool loadCorpus(const std::string &path, std::vector<BenchPosition> &positions)
+    {
+        std::ifstream in(path);
+        if (!in)
+            return false;
+        std::string line;
+        int lineNo = 0;
+        while (std::getline(in, line))
+        {
+            ++lineNo;
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::istringstream is(line);
+            BenchPosition pos;
+            std::string accepted, record;
+            if (!(is >> pos.category >> pos.name >> accepted >> record) || !replay(pos.game, record))
+            {
+                std::cerr << path << ":" << lineNo << ": 无法解析的局面\n";
+                continue;
+            }
+            pos.accepted = parseAccepted(accepted);
+            positions.push_back(std::move(pos));
+        }
+        return true;
+    }
+
+    RunResult run(const BenchPosition &pos, const SearchLimits &limits, int threads)
+    {
+        RunResult result;
+        AiPlayer ai(pos.game.getCurrentPlayer());
+        ai.loadBook(""); // 不使用开局库，只测搜索本身
+        ai.setSearchLimits(limits);
+        ai.setThreads(threads);
+        ai.setStatsListener([&result](const SearchStats &stats)
+                            {
+            if (stats.final)
+                result.stats = stats;
+            else
+                result.timeToDepth.push_back(stats.timeMs); }, true);
+        result.move = ai.getNextMove(pos.game.getBoardView());
+        return result;
+    }
+
+    bool isSolved(const BenchPosition &pos, const RunResult &r)
+    {
+        return std::find(pos.accepted.begin(), pos.accepted.end(), r.move) != pos.accepted.end();
+    }
+
+    void writeRun(std::ostream &out, const RunResult &r)
+    {
+        const SearchStats &s = r.stats;
+        out << "{\"move\": [" << r.move.first << ", " << r.move.second << "]"
+            << ", \"depth\": " << s.depth
+            << ", \"seldepth\": " << s.seldepth
+            << ", \"score\": " << s.score
+            << ", \"nodes\": " << s.nodes
+            << ", \"threatNodes\": " << s.threatNodes
+            << ", \"timeMs\": " << s.timeMs
+            << ", \"nps\": " << s.nps
+            << ", \"timeToDepth\": [";
+        for (size_t i = 0; i < r.timeToDepth.size(); ++i)
+            out << (i ? ", " : "") << r.timeToDepth[i];
+        out << "]}";
+    }
+
+    bool parseOptions(int argc, char **argv, Options &opt)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (i + 1 >= argc)
+                return false;
+            std::string value = argv[++i];
+            if (arg == "--corpus")
+                opt.corpus = value;
+            else if (arg == "--json")
+                opt.jsonPath = value;
+            else if (arg == "--depth")
+                opt.depth = std::atoi(value.c_str());
+            else if (arg == "--time")
+                opt.timeMs = std::atoi(value.c_str());
+            else if (arg == "--threads")
+                opt.threads = std::atoi(value.c_str());
+            else if (arg == "--kernel")
+                opt.kernel = value;
+            else
+                return false;
+        }
+        return opt.depth > 0 && opt.timeMs > 0 && opt.threads >= 0 &&
+               (opt.kernel.empty() || opt.kernel == "scalar" || opt.kernel == "avx2");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options opt;
+    if (!parseOptions(argc, argv, opt))
+    {
+        std::cerr << "用法: " << argv[0]
+                  << " [--corpus 文件] [--depth N] [--time 毫秒] [--threads N] [--kernel scalar|avx2] [--json 文件]\n";
+        return 2;
+    }
+    if (!opt.kernel.empty() &&
+        !PatternBatch::setKernel(opt.kernel == "avx2" ? PatternBatch::Kernel::Avx2 : PatternBatch::Kernel::Scalar))
+    {
+        std::cerr << "CPU 不支持 " << opt.kernel << " 内核\n";
+        return 2;
+    }
+
+    std::vector<BenchPosition> positions;
+    if (!loadCorpus(opt.corpus, positions) || positions.empty())
+    {
+        std::cerr << "无法读取局面集: " << opt.corpus << "\n";
+        return 1;
+    }
+
+    SearchLimits depthLimits;
+    depthLimits.maxDepth = opt.depth;
+    depthLimits.timeMs = FIXED_DEPTH_TIME_MS;
+    SearchLimits timeLimits;
+    timeLimits.timeMs = opt.timeMs;
+
+    std::ostringstream json;
+    json << "{\n  \"version\": " << JSON_VERSION << ",\n"
+         << "  \"config\": {\"depth\": " << opt.depth << ", \"timeMs\": " << opt.timeMs
+         << ", \"threads\": " << opt.threads
+         << ", \"kernel\": \"" << PatternBatch::kernelName(PatternBatch::activeKernel()) << "\""
+         << ", \"positions\": " << positions.size() << "},\n"
+         << "  \"positions\": [\n";
+
+    uint64_t depthNodes = 0, depthTime = 0, timeNodes = 0, timeTime = 0;
+    int puzzles = 0, solved = 0;
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        const BenchPosition &pos = positions[i];
+        RunResult fixedDepth = run(pos, depthLimits, opt.threads);
+        RunResult fixedTime = run(pos, timeLimits, opt.threads);
+
+        depthNodes += fixedDepth.stats.nodes + fixedDepth.stats.threatNodes;
+        depthTime += fixedDepth.stats.timeMs;
+        timeNodes += fixedTime.stats.nodes + fixedTime.stats.threatNodes;
+        timeTime += fixedTime.stats.timeMs;
+
+        // 有正解的局面以定时搜索的着法判定
+        bool judged = !pos.accepted.empty();
+        bool ok = judged && isSolved(pos, fixedTime);
+        puzzles += judged;
+        solved += ok;
+
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-12s %-16s depth %2d %7d ms %10llu nps | time depth %2d %10llu nps%s\n",
+                      pos.category.c_str(), pos.name.c_str(), fixedDepth.stats.depth, fixedDepth.stats.timeMs,
+                      (unsigned long long)fixedDepth.stats.nps, fixedTime.stats.depth,
+                      (unsigned long long)fixedTime.stats.nps, judged ? (ok ? "  solved" : "  FAILED") : "");
+        std::cerr << line;
+
+        json << "    {\"name\": \"" << pos.name << "\", \"category\": \"" << pos.category << "\""
+             << ", \"solved\": " << (judged ? (ok ? "true" : "false") : "null")
+             << ",\n     \"fixedDepth\": ";
+        writeRun(json, fixedDepth);
+        json << ",\n     \"fixedTime\": ";
+        writeRun(json, fixedTime);
+        json << "}" << (i + 1 < positions.size() ? "," : "") << "\n";
+    }
+
+    json << "  ],\n  \"summary\": {"
+         << "\"fixedDepthNodes\": " << depthNodes
+         << ", \"fixedDepthTimeMs\": " << depthTime
+         << ", \"fixedDepthNps\": " << depthNodes * 1000 / std::max<uint64_t>(1, depthTime)
+         << ", \"fixedTimeNodes\": " << timeNodes
+         << ", \"fixedTimeNps\": " << timeNodes * 1000 / std::max<uint64_t>(1, timeTime)
+         << ", \"puzzles\": " << puzzles
+         << ", \"solved\": " << solved << "}\n}\n";
+
+    std::cerr << "solved " << solved << "/" << puzzles << ", fixed-depth "
+              << depthNodes * 1000 / std::max<uint64_t>(1, depthTime) << " nps\n";
+
+    if (opt.jsonPath.empty())
+    {
+        std::cout << json.str();
+    }
+    else
+    {
+        std::ofstream out(opt.jsonPath);
+        out << json.str();
+        if (!out)
+            return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,9 @@
+# 开局库生成：从自对弈日志或对局记录统计前几手，写出 AiPlayer 使用的 book/opening.bin
+TEMPLATE = app
+TARGET = gomoku-book
+CONFIG += c++17 console
+CONFIG -= qt app_bundle
+
+include(../engine.pri)
+
+SOURCES += main.cpp
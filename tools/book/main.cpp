@@ -0,0 +1,134 @@
+// 开局库生成：读取对局文件，统计每局前若干手在各局面下的着法次数，生成 OpeningBook 的二进制文件。
+// 用法：
+//   gomoku-book [--out 文件] [--plies N] [--min-count N] 对局文件...
+// 对局文件每行一局，可以是 gomoku-selfplay 的日志，也可以是 Game::serialize 的记录；
+// 只收录默认尺寸（GameConfig::DEFAULT_BOARD_SIZE）的对局。
+
+#include "GameConfig.h"
+#include "OpeningBook.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        std::string out = GameConfig::DEFAULT_AI_BOOK_PATH;
+        std::vector<std::string> inputs;
+        int plies = GameConfig::DEFAULT_AI_BOOK_PLIES;
+        int minCount = 2;
+    };
+
+    bool parseOptions(int argc, char **argv, Options &opt)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg.compare(0, 2, "--") != 0)
+            {
+                opt.inputs.push_back(arg);
+                continue;
+            }
+            if (i + 1 >= argc)
+                return false;
+            std::string value = argv[++i];
+            if (arg == "--out")
+                opt.out = value;
+            else if (arg == "--plies")
+                opt.plies = std::atoi(value.c_str());
+            else if (arg == "--min-count")
+                opt.minCount = std::atoi(value.c_str());
+            else
+                return false;
+        }
+        return !opt.inputs.empty() && opt.plies > 0 && opt.minCount > 0;
+    }
+
+    // gomoku-selfplay 日志："序号 对号 A|B 结果 手数 着法"，着法每手两个字母；转为 Game::serialize 记录
+    bool selfplayToRecord(const std::string &line, std::string &record)
+    {
+        std::istringstream is(line);
+        int index, pair, plies;
+        std::string black, outcome, text;
+        if (!(is >> index >> pair >> black >> outcome >> plies >> text) || text.size() != size_t(plies) * 2)
+            return false;
+        std::ostringstream oss;
+        oss << "v:1;s:" << GameConfig::DEFAULT_BOARD_SIZE << "||";
+        for (size_t i = 0; i + 1 < text.size(); i += 2)
+            oss << (i ? ";" : "") << (i / 2) % 2 << "," << text[i] - 'a' << "," << text[i + 1] - 'a';
+        record = oss.str();
+        return true;
+    }
+
+    // 读入一个对局文件中的全部记录，返回读到的局数，文件无法打开时返回 -1
+    int readRecords(const std::string &path, std::vector<std::string> &records)
+    {
+        std::ifstream in(path);
+        if (!in)
+            return -1;
+        int added = 0;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::string record;
+            size_t sep = line.find("||");
+            if (sep != std::string::npos)
+            {
+                size_t s = line.find("s:");
+                if (s != std::string::npos && s < sep && std::atoi(line.c_str() + s + 2) != GameConfig::DEFAULT_BOARD_SIZE)
+                    continue;
+                record = line;
+            }
+            else if (!selfplayToRecord(line, record))
+            {
+                continue;
+            }
+            records.push_back(record);
+            ++added;
+        }
+        return added;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options opt;
+    if (!parseOptions(argc, argv, opt))
+    {
+        std::cerr << "用法: " << argv[0] << " [--out 文件] [--plies N] [--min-count N] 对局文件...\n";
+        return 1;
+    }
+
+    std::vector<std::string> records;
+    for (const std::string &path : opt.inputs)
+    {
+        int added = readRecords(path, records);
+        if (added < 0)
+        {
+            std::cerr << "无法读取: " << path << "\n";
+            return 1;
+        }
+        std::cerr << path << ": " << added << " 局\n";
+    }
+
+    if (!OpeningBook::build(records, GameConfig::DEFAULT_BOARD_SIZE, opt.plies, opt.minCount, opt.out))
+    {
+        std::cerr << "无法写入开局库: " << opt.out << "\n";
+        return 1;
+    }
+
+    OpeningBook book;
+    if (!book.open(opt.out))
+    {
+        std::cerr << "生成的开局库无法打开: " << opt.out << "\n";
+        return 1;
+    }
+    std::cout << opt.out << ": " << book.entryCount() << " 条着法，来自 " << records.size() << " 局\n";
+    return 0;
+}
@@ -0,0 +1,30 @@
+# 无界面工具共用的引擎源码（src/core 中不依赖 Qt 的部分）
+CORE = $$PWD/../src/core
+
+INCLUDEPATH += $$CORE \
+               $$PWD/../src/utils
+
+SOURCES += $$CORE/AiEngine.cpp \
+           $$CORE/AiPlayer.cpp \
+           $$CORE/Bitboard.cpp \
+           $$CORE/CandidateSet.cpp \
+           $$CORE/CpuFeatures.cpp \
+           $$CORE/Evaluator.cpp \
+           $$CORE/Game.cpp \
+           $$CORE/GameRecord.cpp \
+           $$CORE/Heuristics.cpp \
+           $$CORE/MctsPlayer.cpp \
+           $$CORE/MovePicker.cpp \
+           $$CORE/Nnue.cpp \
+           $$CORE/OpeningBook.cpp \
+           $$CORE/PatternBatch.cpp \
+           $$CORE/PatternTable.cpp \
+           $$CORE/Position.cpp \
+           $$CORE/ProofSolver.cpp \
+           $$CORE/ThreatSolver.cpp \
+           $$CORE/Threats.cpp \
+           $$CORE/TimeManager.cpp \
+           $$CORE/TranspositionTable.cpp \
+           $$CORE/Zobrist.cpp
+
+unix: LIBS += -lpthread
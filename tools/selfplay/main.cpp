@@ -0,0 +1,367 @@
+// 无界面的自对弈比赛：两组 AI 配置在随机均衡开局上多线程并行对局，统计 Elo 并做 SPRT 检验。
+// 用法：gomoku-selfplay [--a 配置] [--b 配置] [--games N] [--concurrency N] [--opening-plies N]
+//                      [--seed N] [--elo0 E] [--elo1 E] [--alpha A] [--beta B] [--log 文件]
+// 配置为逗号分隔的 key=value：engine（ab 或 mcts，默认 ab）、depth、time（毫秒）、nodes（mcts 下为每步模拟次数）、
+// hash（MB）、threads、book（0/1）、nnue（权重文件，使用 NNUE 评估）；hash/threads/book/nnue 只对 ab 有效
+// 每个开局按先后手互换各下一局；规则由 Game 判定（落子合法性与五连）。
+// 日志每局一行：序号 开局号 执黑方 结果 手数 着法，着法每手两个字母（列、行，a 起）。
+
+#include "AiEngine.h"
+#include "AiPlayer.h"
+#include "Game.h"
+#include "Position.h"
+#include "Threats.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr int BALANCE_LIMIT = 150; // 开局局面分绝对值上限（走子方视角）
+    constexpr int OPENING_AREA = 5;    // 开局在中心 OPENING_AREA × OPENING_AREA 范围内随机落子
+    constexpr int OPENING_RETRIES = 200; // 连续这么多次不满足均衡条件就把开局区域向外扩一圈
+    constexpr int REPORT_EVERY = 20;   // 每完成多少局输出一次进度
+
+    struct EngineConfig
+    {
+        AiEngine::Kind kind = AiEngine::Kind::AlphaBeta;
+        SearchLimits limits;
+        int hashMb = GameConfig::DEFAULT_AI_HASH_MB;
+        int threads = 1;
+        bool book = false;
+        std::string nnue; // 为空时使用棋形评估
+        std::string text;
+    };
+
+    struct Options
+    {
+        EngineConfig a, b;
+        int games = 1000;
+        int concurrency = 0;
+        int openingPlies = 4;
+        unsigned seed = 1;
+        double elo0 = 0, elo1 = 5, alpha = 0.05, beta = 0.05;
+        std::string logPath = "selfplay.log";
+    };
+
+    enum class Outcome
+    {
+        AWin,
+        BWin,
+        Draw
+    };
+
+    struct Tally
+    {
+        int wins = 0, losses = 0, draws = 0; // A 方视角
+
+        int total() const { return wins + losses + draws; }
+        double score() const { return total() ? (wins + 0.5 * draws) / total() : 0.5; }
+        // 每局得分的方差
+        double variance() const
+        {
+            if (!total())
+                return 0;
+            double s = score();
+            return (wins * (1 - s) * (1 - s) + draws * (0.5 - s) * (0.5 - s) + losses * s * s) / total();
+        }
+    };
+
+    double eloToScore(double elo) { return 1 / (1 + std::pow(10.0, -elo / 400)); }
+
+    double scoreToElo(double score)
+    {
+        score = std::min(std::max(score, 1e-6), 1 - 1e-6);
+        return -400 * std::log10(1 / score - 1);
+    }
+
+    // 三项分布的对数似然比（正态近似）
+    double llr(const Tally &t, double elo0, double elo1)
+    {
+        double var = t.variance();
+        if (t.total() == 0 || var <= 0)
+            return 0;
+        double s0 = eloToScore(elo0), s1 = eloToScore(elo1);
+        return t.total() * (s1 - s0) * (2 * t.score() - s0 - s1) / (2 * var);
+    }
+
+    bool parseEngine(const std::string &text, EngineConfig &cfg)
+    {
+        cfg.text = text;
+        std::stringstream ss(text);
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            size_t eq = item.find('=');
+            if (eq == std::string::npos)
+                return false;
+            std::string key = item.substr(0, eq);
+            long long value = std::atoll(item.c_str() + eq + 1);
+            if (key == "engine")
+            {
+                std::string name = item.substr(eq + 1);
+                if (name != "ab" && name != "mcts")
+                    return false;
+                cfg.kind = name == "mcts" ? AiEngine::Kind::Mcts : AiEngine::Kind::AlphaBeta;
+            }
+            else if (key == "depth")
+                cfg.limits.maxDepth = static_cast<int>(value);
+            else if (key == "time")
+                cfg.limits.timeMs = static_cast<int>(value);
+            else if (key == "nodes")
+                cfg.limits.nodes = static_cast<uint64_t>(value);
+            else if (key == "hash")
+                cfg.hashMb = static_cast<int>(value);
+            else if (key == "threads")
+                cfg.threads = static_cast<int>(value);
+            else if (key == "book")
+                cfg.book = value != 0;
+            else if (key == "nnue")
+                cfg.nnue = item.substr(eq + 1);
+            else
+                return false;
+        }
+        // 权重文件在开赛前检查一次，避免每局都加载失败；MCTS 不使用评估函数
+        if (cfg.nnue.empty())
+            return true;
+        NnueNetwork network;
+        return cfg.kind == AiEngine::Kind::AlphaBeta && network.load(cfg.nnue);
+    }
+
+    bool parseOptions(int argc, char **argv, Options &opt)
+    {
+        parseEngine("depth=4,time=200", opt.a);
+        parseEngine("depth=4,time=200", opt.b);
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (i + 1 >= argc)
+                return false;
+            std::string value = argv[++i];
+            if (arg == "--a" && parseEngine(value, opt.a))
+                continue;
+            if (arg == "--b" && parseEngine(value, opt.b))
+                continue;
+            if (arg == "--games")
+                opt.games = std::atoi(value.c_str());
+            else if (arg == "--concurrency")
+                opt.concurrency = std::atoi(value.c_str());
+            else if (arg == "--opening-plies")
+                opt.openingPlies = std::atoi(value.c_str());
+            else if (arg == "--seed")
+                opt.seed = static_cast<unsigned>(std::atoll(value.c_str()));
+            else if (arg == "--elo0")
+                opt.elo0 = std::atof(value.c_str());
+            else if (arg == "--elo1")
+                opt.elo1 = std::atof(value.c_str());
+            else if (arg == "--alpha")
+                opt.alpha = std::atof(value.c_str());
+            else if (arg == "--beta")
+                opt.beta = std::atof(value.c_str());
+            else if (arg == "--log")
+                opt.logPath = value;
+            else
+                return false;
+        }
+        return opt.games > 0 && opt.openingPlies >= 0 && opt.openingPlies <= OPENING_AREA * OPENING_AREA &&
+               opt.alpha > 0 && opt.beta > 0;
+    }
+
+    // 在中心区域随机落子，直到走子方视角的局面分足够接近 0 且双方都没有成五点；
+    // 手数接近区域格数时很难满足条件，屡次失败后逐步扩大区域
+    std::vector<std::pair<int, int>> makeOpening(std::mt19937 &rng, int plies)
+    {
+        int size = GameConfig::DEFAULT_BOARD_SIZE;
+        int area = OPENING_AREA;
+        for (int attempt = 1;; ++attempt)
+        {
+            if (attempt % OPENING_RETRIES == 0 && area + 2 <= size)
+                area += 2;
+            int lo = (size - area) / 2;
+            Position pos{Bitboard(size)};
+            std::vector<std::pair<int, int>> moves;
+            Piece side = Piece::BLACK;
+            while (static_cast<int>(moves.size()) < plies)
+            {
+                int x = lo + static_cast<int>(rng() % area);
+                int y = lo + static_cast<int>(rng() % area);
+                if (!pos.board().isEmpty(x, y))
+                    continue;
+                pos.makeMove(x, y, side);
+                moves.push_back({x, y});
+                side = BoardBits::opponent(side);
+            }
+            bool threats = Threats::windowCells(pos.board(), 0, 4).any() || Threats::windowCells(pos.board(), 1, 4).any();
+            if (!threats && std::abs(pos.evaluate(side)) <= BALANCE_LIMIT)
+                return moves;
+        }
+    }
+
+    std::unique_ptr<AiEngine> makePlayer(const EngineConfig &cfg, Piece color)
+    {
+        std::unique_ptr<AiEngine> engine = AiEngine::create(cfg.kind, color);
+        engine->setSearchLimits(cfg.limits);
+        if (cfg.kind != AiEngine::Kind::AlphaBeta)
+            return engine;
+
+        auto *ai = static_cast<AiPlayer *>(engine.get());
+        if (!cfg.book)
+            ai->loadBook(""); // 关闭开局库，保证双方都从同一开局开始思考
+        ai->setHashSize(cfg.hashMb);
+        ai->setThreads(cfg.threads);
+        if (!cfg.nnue.empty() && ai->loadNetwork(cfg.nnue))
+            ai->setEvalKind(EvalKind::Nnue);
+        return engine;
+    }
+
+    // 下一局，aBlack 为 A 方是否执黑；moves 返回完整着法
+    Outcome playGame(const Options &opt, const std::vector<std::pair<int, int>> &opening, bool aBlack,
+                     std::vector<std::pair<int, int>> &moves)
+    {
+        Game game;
+        bool ended = false;
+        game.setOnGameEnded([&ended](const std::string &)
+                            { ended = true; });
+        game.start();
+
+        auto black = makePlayer(aBlack ? opt.a : opt.b, Piece::BLACK);
+        auto white = makePlayer(aBlack ? opt.b : opt.a, Piece::WHITE);
+        auto outcomeFor = [aBlack](Piece winner)
+        {
+            return (winner == Piece::BLACK) == aBlack ? Outcome::AWin : Outcome::BWin;
+        };
+
+        moves.clear();
+        for (const auto &m : opening)
+        {
+            game.move(m.first, m.second);
+            moves.push_back(m);
+        }
+
+        int cells = GameConfig::DEFAULT_BOARD_SIZE * GameConfig::DEFAULT_BOARD_SIZE;
+        while (static_cast<int>(moves.size()) < cells)
+        {
+            Piece side = game.getCurrentPlayer();
+            AiEngine &ai = side == Piece::BLACK ? *black : *white;
+            std::pair<int, int> m = ai.getNextMove(game.getBoardView());
+            // 非法着法判负
+            if (!game.move(m.first, m.second))
+                return outcomeFor(BoardBits::opponent(side));
+            moves.push_back(m);
+            if (ended)
+                return outcomeFor(side);
+        }
+        return Outcome::Draw;
+    }
+
+    std::string encodeMoves(const std::vector<std::pair<int, int>> &moves)
+    {
+        std::string s;
+        for (const auto &m : moves)
+        {
+            s += static_cast<char>('a' + m.first);
+            s += static_cast<char>('a' + m.second);
+        }
+        return s;
+    }
+
+    void report(std::ostream &out, const Tally &t, const Options &opt)
+    {
+        double elo = scoreToElo(t.score());
+        double margin = t.total() ? 1.96 * std::sqrt(t.variance() / t.total()) : 0;
+        double lo = scoreToElo(t.score() - margin), hi = scoreToElo(t.score() + margin);
+        char line[256];
+        std::snprintf(line, sizeof(line), "games %d  +%d -%d =%d  elo %+.1f [%+.1f, %+.1f]  llr %.2f [%.2f, %.2f]\n",
+                      t.total(), t.wins, t.losses, t.draws, elo, lo, hi, llr(t, opt.elo0, opt.elo1),
+                      std::log(opt.beta / (1 - opt.alpha)), std::log((1 - opt.beta) / opt.alpha));
+        out << line;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options opt;
+    if (!parseOptions(argc, argv, opt))
+    {
+        std::cerr << "用法: " << argv[0] << " [--a 配置] [--b 配置] [--games N] [--concurrency N] [--opening-plies N]"
+                  << " [--seed N] [--elo0 E] [--elo1 E] [--alpha A] [--beta B] [--log 文件]\n";
+        return 2;
+    }
+
+    std::ofstream log(opt.logPath, std::ios::trunc);
+    if (!log)
+    {
+        std::cerr << "无法写入日志: " << opt.logPath << "\n";
+        return 1;
+    }
+    log << "# A: " << opt.a.text << "\n# B: " << opt.b.text << "\n# seed " << opt.seed << "\n";
+
+    // 开局按对生成：第 2k 局 A 执黑，第 2k+1 局 B 执黑
+    std::mt19937 rng(opt.seed);
+    std::vector<std::vector<std::pair<int, int>>> openings((opt.games + 1) / 2);
+    for (auto &o : openings)
+        o = makeOpening(rng, opt.openingPlies);
+
+    const double lower = std::log(opt.beta / (1 - opt.alpha));
+    const double upper = std::log((1 - opt.beta) / opt.alpha);
+
+    Tally tally;
+    std::mutex mutex;
+    std::atomic<int> nextGame{0};
+    std::atomic<bool> stop{false};
+
+    auto worker = [&]
+    {
+        std::vector<std::pair<int, int>> moves;
+        int index;
+        while (!stop && (index = nextGame++) < opt.games)
+        {
+            int pair = index / 2;
+            bool aBlack = index % 2 == 0;
+            Outcome outcome = playGame(opt, openings[pair], aBlack, moves);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            const char *result = outcome == Outcome::Draw ? "1/2" : ((outcome == Outcome::AWin) == aBlack ? "1-0" : "0-1");
+            log << index << ' ' << pair << ' ' << (aBlack ? 'A' : 'B') << ' ' << result << ' ' << moves.size() << ' '
+                << encodeMoves(moves) << '\n';
+            log.flush();
+
+            if (outcome == Outcome::AWin)
+                ++tally.wins;
+            else if (outcome == Outcome::BWin)
+                ++tally.losses;
+            else
+                ++tally.draws;
+            if (tally.total() % REPORT_EVERY == 0)
+                report(std::cerr, tally, opt);
+
+            // SPRT 越过任一边界即停止派发新对局（已开始的对局下完）
+            double l = llr(tally, opt.elo0, opt.elo1);
+            if (l <= lower || l >= upper)
+                stop = true;
+        }
+    };
+
+    int concurrency = opt.concurrency > 0 ? opt.concurrency : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> pool;
+    for (int i = 0; i < concurrency; ++i)
+        pool.emplace_back(worker);
+    for (auto &t : pool)
+        t.join();
+
+    report(std::cout, tally, opt);
+    double l = llr(tally, opt.elo0, opt.elo1);
+    std::cout << "sprt: " << (l >= upper ? "H1 accepted" : l <= lower ? "H0 accepted" : "inconclusive") << "\n";
+    return 0;
+}
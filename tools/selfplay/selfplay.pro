@@ -0,0 +1,9 @@
+# 无界面的自对弈比赛：两组 AiPlayer 配置多线程并行对局，统计 Elo 与 SPRT
+TEMPLATE = app
+TARGET = gomoku-selfplay
+CONFIG += c++17 console
+CONFIG -= qt app_bundle
+
+include(../engine.pri)
+
+SOURCES += main.cpp
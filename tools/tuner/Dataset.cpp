@@ -0,0 +1,217 @@
+#include "Dataset.h"
+#include "Bitboard.h"
+#include "Threats.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace BoardBits;
+
+namespace
+{
+    constexpr char MAGIC[8] = {'G', 'M', 'K', 'T', 'U', 'N', 'E', '1'};
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t boardSize;
+        uint64_t count;
+    };
+
+    static_assert(sizeof(Header) == 24, "dataset header layout");
+
+    template <typename T>
+    void put(std::ostream &out, T value)
+    {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    bool get(std::istream &in, T &value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+    }
+
+    // Game::serialize 记录："v:1;s:15||p,x,y;p,x,y;..."
+    bool parseRecord(const std::string &line, int &boardSize, std::vector<std::pair<int, int>> &moves)
+    {
+        size_t sep = line.find("||");
+        if (sep == std::string::npos)
+            return false;
+        size_t s = line.find("s:");
+        if (s != std::string::npos && s < sep)
+            boardSize = std::atoi(line.c_str() + s + 2);
+        std::stringstream ss(line.substr(sep + 2));
+        std::string item;
+        while (std::getline(ss, item, ';'))
+        {
+            int p, x, y;
+            char c1, c2;
+            std::istringstream is(item);
+            if (!(is >> p >> c1 >> x >> c2 >> y) || c1 != ',' || c2 != ',')
+                return false;
+            moves.push_back({x, y});
+        }
+        return true;
+    }
+
+    // gomoku-selfplay 日志："序号 对号 A|B 1-0|0-1|1/2 手数 着法"，着法每手两个字母
+    bool parseSelfplay(const std::string &line, uint8_t &result, std::vector<std::pair<int, int>> &moves)
+    {
+        std::istringstream is(line);
+        int index, pair, plies;
+        std::string black, outcome, text;
+        if (!(is >> index >> pair >> black >> outcome >> plies))
+            return false;
+        is >> text;
+        if (outcome == "1-0")
+            result = 2;
+        else if (outcome == "0-1")
+            result = 0;
+        else if (outcome == "1/2")
+            result = 1;
+        else
+            return false;
+        if (text.size() != size_t(plies) * 2)
+            return false;
+        for (size_t i = 0; i + 1 < text.size(); i += 2)
+            moves.push_back({text[i] - 'a', text[i + 1] - 'a'});
+        return true;
+    }
+}
+
+namespace Dataset
+{
+    bool write(const std::string &path, int boardSize, const std::vector<TuneGame> &games)
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.boardSize = static_cast<uint32_t>(boardSize);
+        header.count = games.size();
+        put(out, header);
+
+        bool compact = boardSize <= 16;
+        for (const TuneGame &g : games)
+        {
+            put(out, g.result);
+            put(out, static_cast<uint16_t>(g.moves.size()));
+            put(out, static_cast<uint16_t>(g.plies.size()));
+            for (uint16_t ply : g.plies)
+                put(out, ply);
+            for (const auto &m : g.moves)
+            {
+                if (compact)
+                    put(out, static_cast<uint8_t>(m.first << 4 | m.second));
+                else
+                    put(out, static_cast<uint16_t>(m.first * boardSize + m.second));
+            }
+        }
+        return static_cast<bool>(out);
+    }
+
+    bool read(const std::string &path, int &boardSize, std::vector<TuneGame> &games)
+    {
+        std::ifstream in(path, std::ios::binary);
+        Header header;
+        if (!in || !get(in, header) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+            header.version != VERSION)
+            return false;
+        boardSize = static_cast<int>(header.boardSize);
+        bool compact = boardSize <= 16;
+
+        games.clear();
+        games.reserve(header.count);
+        for (uint64_t i = 0; i < header.count; ++i)
+        {
+            TuneGame g;
+            uint16_t moveCount, sampleCount;
+            if (!get(in, g.result) || !get(in, moveCount) || !get(in, sampleCount))
+                return false;
+            g.plies.resize(sampleCount);
+            for (uint16_t &ply : g.plies)
+            {
+                if (!get(in, ply) || ply > moveCount)
+                    return false;
+            }
+            g.moves.resize(moveCount);
+            for (auto &m : g.moves)
+            {
+                if (compact)
+                {
+                    uint8_t v;
+                    if (!get(in, v))
+                        return false;
+                    m = {v >> 4, v & 15};
+                }
+                else
+                {
+                    uint16_t v;
+                    if (!get(in, v))
+                        return false;
+                    m = {v / boardSize, v % boardSize};
+                }
+            }
+            games.push_back(std::move(g));
+        }
+        return true;
+    }
+
+    int extract(const std::string &path, int skip, std::vector<TuneGame> &games)
+    {
+        std::ifstream in(path);
+        if (!in)
+            return -1;
+        int added = 0;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+
+            TuneGame g;
+            int boardSize = GameConfig::DEFAULT_BOARD_SIZE;
+            bool record = line.find("||") != std::string::npos;
+            if (record ? !parseRecord(line, boardSize, g.moves) : !parseSelfplay(line, g.result, g.moves))
+                continue;
+            if (boardSize != GameConfig::DEFAULT_BOARD_SIZE)
+                continue;
+
+            // 逐手重放：非法着法丢弃整局；对局记录没有结果字段，以最后一手是否成五判定
+            Bitboard board(boardSize);
+            Piece side = Piece::BLACK;
+            bool legal = true;
+            bool five = false;
+            for (size_t ply = 0; ply < g.moves.size() && legal; ++ply)
+            {
+                int x = g.moves[ply].first, y = g.moves[ply].second;
+                legal = !five && board.inBoard(x, y) && board.isEmpty(x, y);
+                if (!legal)
+                    break;
+
+                // 只取平静局面：双方都没有成五点，静态评估才有意义
+                int me = colorIndex(side);
+                if (int(ply) >= skip && !Threats::windowCells(board, me, 4).any() &&
+                    !Threats::windowCells(board, me ^ 1, 4).any())
+                    g.plies.push_back(static_cast<uint16_t>(ply));
+
+                board.place(x, y, side);
+                five = board.isFive(x, y, side);
+                side = opponent(side);
+            }
+            if (!legal || g.plies.empty())
+                continue;
+            if (record)
+                g.result = !five ? 1 : (g.moves.size() % 2 ? 2 : 0);
+
+            added += static_cast<int>(g.plies.size());
+            games.push_back(std::move(g));
+        }
+        return added;
+    }
+}
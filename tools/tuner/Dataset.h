@@ -0,0 +1,37 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 调参数据集
+ *
+ * 按对局存储，同一局的各个局面共用着法序列。文件格式（小端）：
+ *   Header { char magic[8] = "GMKTUNE1"; uint32 version; uint32 boardSize; uint64 count; }
+ *   Game[count] { uint8 result; uint16 moveCount; uint16 sampleCount; uint16 plies[sampleCount]; Move moves[moveCount]; }
+ * result 为黑方视角（0 负 / 1 和 / 2 胜）；plies 为参与调参的局面（第 ply 手之前的局面）；
+ * 边长不超过 16 时每手 1 字节 (x << 4 | y)，否则 2 字节 (x * boardSize + y)。
+ */
+struct TuneGame
+{
+    uint8_t result = 1;
+    std::vector<std::pair<int, int>> moves;
+    std::vector<uint16_t> plies;
+};
+
+namespace Dataset
+{
+    constexpr uint32_t VERSION = 1;
+
+    bool write(const std::string &path, int boardSize, const std::vector<TuneGame> &games);
+    bool read(const std::string &path, int &boardSize, std::vector<TuneGame> &games);
+
+    // 从对局文件提取样本：每行一局，支持 Game::serialize 记录与 gomoku-selfplay 日志；
+    // 跳过前 skip 手，以及任一方已有成五点（非平静）的局面
+    int extract(const std::string &path, int skip, std::vector<TuneGame> &games);
+}
+
+#endif // DATASET_H
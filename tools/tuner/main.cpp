@@ -0,0 +1,379 @@
+// 评估权重调参（Texel 方法）：从对局中提取平静局面并以对局结果为标签，
+// 最小化 sigmoid(评估分) 与结果之间的均方误差，输出可直接编译进引擎的 EvalWeights.h。
+// 用法：
+//   gomoku-tuner extract --out 数据集 [--skip N] 对局文件...
+//   gomoku-tuner tune --data 数据集 [--threads N] [--passes N] [--header 文件]
+// 对局文件每行一局，可以是 gomoku-selfplay 的日志，也可以是 Game::serialize 的记录。
+
+#include "Dataset.h"
+#include "EvalWeights.h"
+#include "Evaluator.h"
+#include "PatternTable.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace BoardBits;
+
+namespace
+{
+    constexpr int PATTERNS = PatternTable::PATTERNS;
+    constexpr int FIVE = 0; // 连五的分值只用于判胜负，不参与调参
+
+    // 参数向量：各棋形分，之后依次为 OWN_WEIGHT、OPP_WEIGHT、CENTER_WEIGHT
+    constexpr int OWN = PATTERNS;
+    constexpr int OPP = PATTERNS + 1;
+    constexpr int CENTER = PATTERNS + 2;
+    constexpr int PARAMS = PATTERNS + 3;
+
+    struct Sample
+    {
+        float label; // 走子方视角：胜 1，和 0.5，负 0
+        int16_t center;
+        int16_t own[PATTERNS];
+        int16_t opp[PATTERNS];
+    };
+
+    struct Options
+    {
+        std::string out;
+        std::string data;
+        std::string header;
+        std::vector<std::string> inputs;
+        int skip = 6;
+        int threads = 0;
+        int passes = 50;
+    };
+
+    std::vector<int> defaultParams()
+    {
+        std::vector<int> p(EvalWeights::PATTERN_SCORES, EvalWeights::PATTERN_SCORES + PATTERNS);
+        p.push_back(EvalWeights::OWN_WEIGHT);
+        p.push_back(EvalWeights::OPP_WEIGHT);
+        p.push_back(EvalWeights::CENTER_WEIGHT);
+        return p;
+    }
+
+    // 重放每局，在标记的局面上计算双方的棋形计数与位置分差
+    std::vector<Sample> buildSamples(const std::vector<TuneGame> &games, int boardSize)
+    {
+        std::vector<Sample> samples;
+        for (const TuneGame &g : games)
+        {
+            Bitboard board(boardSize);
+            int center[2] = {0, 0};
+            size_t next = 0;
+            for (size_t ply = 0; ply <= g.moves.size() && next < g.plies.size(); ++ply)
+            {
+                int me = ply % 2;
+                if (g.plies[next] == ply)
+                {
+                    ++next;
+                    Sample s;
+                    // result 为黑方视角，白方走子时取反
+                    float black = g.result * 0.5f;
+                    s.label = me == 0 ? black : 1 - black;
+                    s.center = static_cast<int16_t>(center[me] - center[me ^ 1]);
+                    int own[PATTERNS], opp[PATTERNS];
+                    Evaluator::countPatterns(board, me, own);
+                    Evaluator::countPatterns(board, me ^ 1, opp);
+                    for (int i = 0; i < PATTERNS; ++i)
+                    {
+                        s.own[i] = static_cast<int16_t>(own[i]);
+                        s.opp[i] = static_cast<int16_t>(opp[i]);
+                    }
+                    samples.push_back(s);
+                }
+                if (ply == g.moves.size())
+                    break;
+                int x = g.moves[ply].first, y = g.moves[ply].second;
+                board.place(x, y, me ? Piece::WHITE : Piece::BLACK);
+                center[me] += Evaluator::centerBonus(board, x, y);
+            }
+        }
+        return samples;
+    }
+
+    // 与 Evaluator::evaluate 相同的公式
+    double evaluate(const Sample &s, const std::vector<int> &p)
+    {
+        int64_t own = 0, opp = 0;
+        for (int i = 0; i < PATTERNS; ++i)
+        {
+            own += int64_t(p[i]) * s.own[i];
+            opp += int64_t(p[i]) * s.opp[i];
+        }
+        return double(own) * p[OWN] / EvalWeights::EVAL_SCALE - double(opp) * p[OPP] / EvalWeights::EVAL_SCALE +
+               double(s.center) * p[CENTER];
+    }
+
+    // 均方误差，按线程数把样本切块并行计算
+    double meanError(const std::vector<Sample> &samples, const std::vector<int> &p, double k, int threads)
+    {
+        std::vector<double> partial(threads, 0.0);
+        std::vector<std::thread> pool;
+        size_t chunk = (samples.size() + threads - 1) / threads;
+        for (int t = 0; t < threads; ++t)
+        {
+            pool.emplace_back([&, t]
+                              {
+                size_t begin = std::min(samples.size(), t * chunk);
+                size_t end = std::min(samples.size(), begin + chunk);
+                double sum = 0;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    double predicted = 1 / (1 + std::pow(10.0, -k * evaluate(samples[i], p) / 400));
+                    double diff = samples[i].label - predicted;
+                    sum += diff * diff;
+                }
+                partial[t] = sum; });
+        }
+        for (std::thread &th : pool)
+            th.join();
+        double sum = 0;
+        for (double v : partial)
+            sum += v;
+        return sum / std::max<size_t>(1, samples.size());
+    }
+
+    // 在对数尺度上做黄金分割搜索，找使误差最小的 sigmoid 缩放系数 K
+    double fitScale(const std::vector<Sample> &samples, const std::vector<int> &p, int threads)
+    {
+        const double ratio = (std::sqrt(5.0) - 1) / 2;
+        double lo = -4, hi = 1;
+        auto error = [&](double logK)
+        { return meanError(samples, p, std::pow(10.0, logK), threads); };
+        double a = hi - ratio * (hi - lo), b = lo + ratio * (hi - lo);
+        double ea = error(a), eb = error(b);
+        for (int i = 0; i < 40; ++i)
+        {
+            if (ea < eb)
+            {
+                hi = b;
+                b = a;
+                eb = ea;
+                a = hi - ratio * (hi - lo);
+                ea = error(a);
+            }
+            else
+            {
+                lo = a;
+                a = b;
+                ea = eb;
+                b = lo + ratio * (hi - lo);
+                eb = error(b);
+            }
+        }
+        return std::pow(10.0, (lo + hi) / 2);
+    }
+
+    // 左右镜像的棋形（如眠三左/右）共用一个分值，返回镜像棋形的下标，没有则返回自身
+    int mirrorOf(int i)
+    {
+        std::string key = PatternTable::patternKey(i);
+        std::reverse(key.begin(), key.end());
+        for (int j = 0; j < PATTERNS; ++j)
+        {
+            if (key == PatternTable::patternKey(j))
+                return j;
+        }
+        return i;
+    }
+
+    // Texel 局部搜索：逐个参数试探 ±步长，误差下降即保留；一轮无改进时步长减半，
+    // 步长足够小仍无改进则收敛
+    std::vector<int> tune(const std::vector<Sample> &samples, std::vector<int> p, double k, int threads, int passes)
+    {
+        std::vector<int> mirror(PARAMS);
+        std::vector<bool> tunable(PARAMS, true);
+        for (int i = 0; i < PARAMS; ++i)
+            mirror[i] = i < PATTERNS ? mirrorOf(i) : i;
+        tunable[FIVE] = false;
+        for (int i = 0; i < PATTERNS; ++i)
+        {
+            bool seen = false;
+            for (const Sample &s : samples)
+                seen = seen || s.own[i] || s.opp[i] || s.own[mirror[i]] || s.opp[mirror[i]];
+            // 数据中从未出现的棋形（如平静局面里的四）保持原值；镜像对只调前一个
+            tunable[i] = tunable[i] && seen && mirror[i] >= i;
+        }
+
+        double best = meanError(samples, p, k, threads);
+        double fraction = 0.25;
+        for (int pass = 0; pass < passes; ++pass)
+        {
+            bool improved = false;
+            for (int i = 0; i < PARAMS; ++i)
+            {
+                if (!tunable[i])
+                    continue;
+                int step = std::max(1, static_cast<int>(std::lround(p[i] * fraction)));
+                for (int sign : {1, -1})
+                {
+                    int old = p[i];
+                    p[i] = p[mirror[i]] = std::max(0, old + sign * step);
+                    if (p[i] == old)
+                        continue;
+                    double e = meanError(samples, p, k, threads);
+                    if (e < best)
+                    {
+                        best = e;
+                        improved = true;
+                        break;
+                    }
+                    p[i] = p[mirror[i]] = old;
+                }
+            }
+            std::cerr << "pass " << pass + 1 << " step " << fraction << " error " << best << "\n";
+            if (!improved)
+            {
+                if (fraction < 0.01)
+                    break;
+                fraction /= 2;
+            }
+        }
+        return p;
+    }
+
+    std::string renderHeader(const std::vector<int> &p)
+    {
+        std::ostringstream out;
+        out << "// 由 tools/tuner 生成，请勿手工修改；重新调参后用 gomoku-tuner tune --header 覆盖本文件\n"
+            << "#ifndef EVALWEIGHTS_H\n#define EVALWEIGHTS_H\n\n"
+            << "/**\n * @brief 评估权重\n *\n"
+            << " * 局面分 = 己方棋形分 × OWN_WEIGHT / EVAL_SCALE - 对方棋形分 × OPP_WEIGHT / EVAL_SCALE + 位置分差，\n"
+            << " * 位置分为每颗子的（棋盘边长 - 到中心的曼哈顿距离）× CENTER_WEIGHT；\n"
+            << " * 落子启发式 = 己方棋形分 + 对方棋形分 × DEFENSE_WEIGHT。\n */\n"
+            << "namespace EvalWeights\n{\n"
+            << "    constexpr int PATTERN_COUNT = " << PATTERNS << ";\n\n"
+            << "    // 棋形分，顺序与 PatternTable 的棋形表一致\n"
+            << "    constexpr int PATTERN_SCORES[PATTERN_COUNT] = {\n";
+        for (int i = 0; i < PATTERNS; ++i)
+        {
+            char line[64];
+            std::snprintf(line, sizeof(line), "        %-9s// %s\n", (std::to_string(p[i]) + ",").c_str(),
+                          PatternTable::patternKey(i));
+            out << line;
+        }
+        out << "    };\n\n"
+            << "    constexpr int EVAL_SCALE = " << EvalWeights::EVAL_SCALE << ";\n"
+            << "    constexpr int OWN_WEIGHT = " << p[OWN] << ";\n"
+            << "    constexpr int OPP_WEIGHT = " << p[OPP] << ";\n"
+            << "    constexpr int CENTER_WEIGHT = " << p[CENTER] << ";\n"
+            << "    constexpr int DEFENSE_WEIGHT = " << EvalWeights::DEFENSE_WEIGHT << ";\n"
+            << "}\n\n#endif // EVALWEIGHTS_H\n";
+        return out.str();
+    }
+
+    bool parseOptions(int argc, char **argv, Options &opt)
+    {
+        for (int i = 2; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (arg.compare(0, 2, "--") != 0)
+            {
+                opt.inputs.push_back(arg);
+                continue;
+            }
+            if (i + 1 >= argc)
+                return false;
+            std::string value = argv[++i];
+            if (arg == "--out")
+                opt.out = value;
+            else if (arg == "--data")
+                opt.data = value;
+            else if (arg == "--header")
+                opt.header = value;
+            else if (arg == "--skip")
+                opt.skip = std::atoi(value.c_str());
+            else if (arg == "--threads")
+                opt.threads = std::atoi(value.c_str());
+            else if (arg == "--passes")
+                opt.passes = std::atoi(value.c_str());
+            else
+                return false;
+        }
+        return opt.skip >= 0 && opt.threads >= 0 && opt.passes > 0;
+    }
+
+    int runExtract(const Options &opt)
+    {
+        std::vector<TuneGame> games;
+        int positions = 0;
+        for (const std::string &path : opt.inputs)
+        {
+            int added = Dataset::extract(path, opt.skip, games);
+            if (added < 0)
+            {
+                std::cerr << "无法读取对局文件: " << path << "\n";
+                return 1;
+            }
+            positions += added;
+        }
+        if (!Dataset::write(opt.out, GameConfig::DEFAULT_BOARD_SIZE, games))
+        {
+            std::cerr << "无法写入数据集: " << opt.out << "\n";
+            return 1;
+        }
+        std::cerr << games.size() << " games, " << positions << " positions\n";
+        return 0;
+    }
+
+    int runTune(const Options &opt)
+    {
+        int boardSize = 0;
+        std::vector<TuneGame> games;
+        if (!Dataset::read(opt.data, boardSize, games))
+        {
+            std::cerr << "无法读取数据集: " << opt.data << "\n";
+            return 1;
+        }
+        std::vector<Sample> samples = buildSamples(games, boardSize);
+        if (samples.empty())
+        {
+            std::cerr << "数据集为空\n";
+            return 1;
+        }
+
+        int threads = opt.threads > 0 ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+        std::vector<int> params = defaultParams();
+        double k = fitScale(samples, params, threads);
+        double before = meanError(samples, params, k, threads);
+        std::cerr << samples.size() << " positions, K = " << k << ", error " << before << "\n";
+
+        params = tune(samples, params, k, threads, opt.passes);
+        std::cerr << "error " << before << " -> " << meanError(samples, params, k, threads) << "\n";
+
+        std::string header = renderHeader(params);
+        if (opt.header.empty())
+        {
+            std::cout << header;
+            return 0;
+        }
+        std::ofstream out(opt.header, std::ios::trunc);
+        out << header;
+        return out ? 0 : 1;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options opt;
+    std::string command = argc > 1 ? argv[1] : "";
+    bool ok = parseOptions(argc, argv, opt);
+    if (ok && command == "extract" && !opt.out.empty() && !opt.inputs.empty())
+        return runExtract(opt);
+    if (ok && command == "tune" && !opt.data.empty() && opt.inputs.empty())
+        return runTune(opt);
+
+    std::cerr << "用法: " << argv[0] << " extract --out 数据集 [--skip N] 对局文件...\n"
+              << "      " << argv[0] << " tune --data 数据集 [--threads N] [--passes N] [--header 文件]\n";
+    return 2;
+}
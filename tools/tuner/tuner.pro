@@ -0,0 +1,11 @@
+# 评估权重调参：从对局提取样本、Texel 方法拟合权重并生成 src/core/EvalWeights.h
+TEMPLATE = app
+TARGET = gomoku-tuner
+CONFIG += c++17 console
+CONFIG -= qt app_bundle
+
+include(../engine.pri)
+
+HEADERS += Dataset.h
+SOURCES += Dataset.cpp \
+           main.cpp